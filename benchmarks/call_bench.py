@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""
+Measures the time taken by a single call to the methods used most often in
+interactive playback, where each call only does a little work.
+
+Run from the top of the source tree after building the extension in place:
+
+	python3 setup.py build_ext --inplace
+	python3 benchmarks/call_bench.py
+"""
+
+import argparse
+import timeit
+
+import pyopl
+
+
+def main() -> None:
+	parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+	parser.add_argument("--count", type=int, default=200000, help="calls per run")
+	parser.add_argument("--repeat", type=int, default=5, help="number of runs, the best is reported")
+	args = parser.parse_args()
+
+	opl = pyopl.opl(49716, 2, 2)
+	buffer = bytearray(2 * 2 * 2)
+	calls = {
+		"writeReg(reg, val)": lambda: opl.writeReg(0x40, 0x3F),
+		"writeReg(reg=, val=)": lambda: opl.writeReg(reg=0x40, val=0x3F),
+		"readReg(reg)": lambda: opl.readReg(0x40),
+		"getSamples(buffer), 2 samples": lambda: opl.getSamples(buffer),
+		"stream(2)": lambda: opl.stream(2),
+	}
+	# Time an empty call too, so the cost of the lambda itself can be seen
+	empty = min(timeit.repeat(lambda: None, number=args.count, repeat=args.repeat))
+	print("%-32s %6.1f ns" % ("(empty lambda)", empty / args.count * 1e9))
+	for name, call in calls.items():
+		best = min(timeit.repeat(call, number=args.count, repeat=args.repeat))
+		print("%-32s %6.1f ns per call" % (name, (best - empty) / args.count * 1e9))
+
+
+if __name__ == "__main__":
+	main()
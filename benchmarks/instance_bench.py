@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""
+Measures how long it takes to create an opl object and how much memory each
+one uses, and how long it takes to reuse one from a pool.
+
+Run from the top of the source tree after building the extension in place:
+
+	python3 setup.py build_ext --inplace
+	python3 benchmarks/instance_bench.py
+"""
+
+import argparse
+import sys
+import timeit
+
+import pyopl
+
+
+def main() -> None:
+	parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+	parser.add_argument("--count", type=int, default=2000, help="objects to create per run")
+	parser.add_argument("--repeat", type=int, default=5, help="number of runs, the best is reported")
+	args = parser.parse_args()
+
+	for rate in (44100, 48000, 49716):
+		for chips in (1, 2):
+			# The first object at a new rate builds the shared tables
+			first = timeit.timeit(lambda: pyopl.opl(rate + chips, 2, 2, chips=chips), number=1)
+			best = min(timeit.repeat(
+				lambda: pyopl.opl(rate, 2, 2, chips=chips),
+				number=args.count,
+				repeat=args.repeat,
+			))
+			size = sys.getsizeof(pyopl.opl(rate, 2, 2, chips=chips))
+			print("%5d Hz, %d chip%s: first %8.1f us, then %6.2f us per object, %6d bytes per object" % (
+				rate, chips, "" if chips == 1 else "s", first * 1e6, best / args.count * 1e6, size))
+
+	# Reusing objects from a pool instead of creating new ones
+	pool = pyopl.pool(4, 49716, 2, 2)
+
+	def cycle() -> None:
+		pool.release(pool.acquire())
+
+	best = min(timeit.repeat(cycle, number=args.count, repeat=args.repeat))
+	print("pool acquire and release: %6.2f us per object" % (best / args.count * 1e6))
+
+
+if __name__ == "__main__":
+	main()
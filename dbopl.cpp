@@ -38,9 +38,20 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <mutex>
 #include "dosbox.h"
 #include "dbopl.h"
 
+//Static tracepoints for perf and bpftrace, only built in with PYOPL_USDT
+//A double underscore in the name shows up as a dash, like pyopl:generate-entry
+#ifdef PYOPL_USDT
+#include <sys/sdt.h>
+#define PROBE3( name, a, b, c ) DTRACE_PROBE3( pyopl, name, a, b, c )
+#else
+#define PROBE3( name, a, b, c )
+#endif
+
 
 #ifndef PI
 #define PI 3.14159265358979323846
@@ -95,21 +106,26 @@ namespace DBOPL {
 //Has to fit within 16bit lookuptable
 #define MUL_SH		16
 
+//Percussion works out the wave positions of its voices this many samples at a time
+#define PERCUSSION_BLOCK	128
+//Most LFO changes looked ahead at while generating a block
+#define LFO_SCHEDULE	64
+//Attenuation preview mode treats as silent, 48dB
+#define PREVIEW_LIMIT	( ( 8 * 256 ) >> ( 3 - ENV_EXTRA ) )
+
+//The lane generator needs gathers to beat the channel loops, so it's built for AVX2 with GCC and clang
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( DBOPL_WAVE == WAVE_TABLEMUL )
+#define LANES_AVX2
+#endif
+//Fewer queued channels than this are left to their own block loops
+#define LANE_MINIMUM	5
+
 //Check some ranges
 #if ENV_EXTRA > 3
 #error Too many envelope bits
 #endif
 
 
-//How much to substract from the base value for the final attenuation
-static const Bit8u KslCreateTable[16] = {
-	//0 will always be be lower than 7 * 8
-	64, 32, 24, 19, 
-	16, 12, 11, 10, 
-	 8,  6,  5,  4,
-	 3,  2,  1,  0,
-};
-
 #define M(_X_) ((Bit8u)( (_X_) * 2))
 static const Bit8u FreqCreateTable[16] = {
 	M(0.5), M(1 ), M(2 ), M(3 ), M(4 ), M(5 ), M(6 ), M(7 ),
@@ -132,15 +148,6 @@ static const Bit8u EnvelopeIncreaseTable[13] = {
 	32, 
 };
 
-#if ( DBOPL_WAVE == WAVE_HANDLER ) || ( DBOPL_WAVE == WAVE_TABLELOG )
-static Bit16u ExpTable[ 256 ];
-#endif
-
-#if ( DBOPL_WAVE == WAVE_HANDLER )
-//PI table used by WAVEHANDLER
-static Bit16u SinTable[ 512 ];
-#endif
-
 #if ( DBOPL_WAVE > WAVE_HANDLER )
 //Layout of the waveform table in 512 entry intervals
 //With overlapping waves we reduce the table to half it's size
@@ -151,7 +158,6 @@ static Bit16u SinTable[ 512 ];
 
 //6 is just 0 shifted and masked
 
-static Bit16s WaveTable[ 8 * 512 ];
 //Distance into WaveTable the wave starts
 static const Bit16u WaveBaseTable[8] = {
 	0x000, 0x200, 0x200, 0x800,
@@ -171,16 +177,14 @@ static const Bit16u WaveStartTable[8] = {
 };
 #endif
 
-#if ( DBOPL_WAVE == WAVE_TABLEMUL )
-static Bit16u MulTable[ 384 ];
-#endif
+#define CHAN_OFFSET( _CH_ ) ( offsetof( Chip, chan ) + ( _CH_ ) * sizeof( Channel ) )
+#define OP_OFFSET( _CH_, _OP_ ) ( CHAN_OFFSET( _CH_ ) + offsetof( Channel, op ) + ( _OP_ ) * sizeof( Operator ) )
+
+//Exponent, wave, ksl, tremolo and register offset tables
+#include "dbopl_tables.h"
 
-static Bit8u KslTable[ 8 * 16 ];
-static Bit8u TremoloTable[ TREMOLO_TABLE ];
-//Start of a channel behind the chip struct start
-static Bit16u ChanOffsetTable[32];
-//Start of an operator behind the chip struct start
-static Bit16u OpOffsetTable[64];
+#undef CHAN_OFFSET
+#undef OP_OFFSET
 
 //The lower bits are the shift of the operator vibrato value
 //The highest bit is right shifted to generate -1 or 0 for negation
@@ -290,7 +294,7 @@ inline void Operator::UpdateAttack( const Chip* chip ) {
 	Bit8u rate = reg60 >> 4;
 	if ( rate ) {
 		Bit8u val = (rate << 2) + ksr;
-		attackAdd = chip->attackRates[ val ];
+		attackAdd = chip->rates->attackRates[ val ];
 		rateZero &= ~(1 << ATTACK);
 	} else {
 		attackAdd = 0;
@@ -301,7 +305,7 @@ inline void Operator::UpdateDecay( const Chip* chip ) {
 	Bit8u rate = reg60 & 0xf;
 	if ( rate ) {
 		Bit8u val = (rate << 2) + ksr;
-		decayAdd = chip->linearRates[ val ];
+		decayAdd = chip->rates->linearRates[ val ];
 		rateZero &= ~(1 << DECAY);
 	} else {
 		decayAdd = 0;
@@ -312,7 +316,7 @@ inline void Operator::UpdateRelease( const Chip* chip ) {
 	Bit8u rate = reg80 & 0xf;
 	if ( rate ) {
 		Bit8u val = (rate << 2) + ksr;
-		releaseAdd = chip->linearRates[ val ];
+		releaseAdd = chip->rates->linearRates[ val ];
 		rateZero &= ~(1 << RELEASE);
 		if ( !(reg20 & MASK_SUSTAIN ) ) {
 			rateZero &= ~( 1 << SUSTAIN );
@@ -469,7 +473,7 @@ void Operator::Write20( const Chip* chip, Bit8u val ) {
 	}
 	//Frequency multiplier or vibrato changed
 	if ( change & (0xf | MASK_VIBRATO) ) {
-		freqMul = chip->freqMul[ val & 0xf ];
+		freqMul = chip->rates->freqMul[ val & 0xf ];
 		UpdateFrequency();
 	}
 }
@@ -534,6 +538,33 @@ INLINE bool Operator::Silent() const {
 	return true;
 }
 
+INLINE bool Operator::Skippable( const Chip* chip ) const {
+	if ( Silent() )
+		return true;
+	//Outside attack the envelope only gets quieter, tremolo only ever adds attenuation
+	return GCC_UNLIKELY( chip->previewLimit ) && state != ATTACK
+		&& (Bit32u)( totalLevel + volume ) >= chip->previewLimit;
+}
+
+INLINE bool Operator::EnvelopeStatic() const {
+	switch ( state ) {
+	case OFF:
+		return true;
+	case SUSTAIN:
+		if ( reg20 & MASK_SUSTAIN )
+			return true;
+		//Not sustaining, so it's a release at the sustain state's rate
+		return ( rateZero & ( 1 << SUSTAIN ) ) && volume < ENV_MAX;
+	case RELEASE:
+		return ( rateZero & ( 1 << RELEASE ) ) && volume < ENV_MAX;
+	case DECAY:
+		return ( rateZero & ( 1 << DECAY ) ) && volume < sustainLevel;
+	case ATTACK:
+		return ( rateZero & ( 1 << ATTACK ) ) != 0;
+	}
+	return false;
+}
+
 INLINE void Operator::Prepare( const Chip* chip )  {
 	currentLevel = totalLevel + (chip->tremoloValue & tremoloMask);
 	waveCurrent = waveAdd;
@@ -588,7 +619,10 @@ INLINE Bits Operator::GetWave( Bitu index, Bitu vol ) {
 }
 
 Bits INLINE Operator::GetSample( Bits modulation ) {
-	Bitu vol = ForwardVolume();
+	return GetSample( modulation, ForwardVolume() );
+}
+
+Bits INLINE Operator::GetSample( Bits modulation, Bitu vol ) {
 	if ( ENV_SILENT( vol ) ) {
 		//Simply forward the wave
 		waveIndex += waveCurrent;
@@ -600,6 +634,22 @@ Bits INLINE Operator::GetSample( Bits modulation ) {
 	}
 }
 
+INLINE void Operator::Skip() {
+	(this->*volHandler)();
+	waveIndex += waveCurrent;
+}
+
+void Operator::Skip( Bitu samples ) {
+	//Envelope can't change, so only the wave moves on
+	if ( EnvelopeStatic() ) {
+		waveIndex += waveCurrent * samples;
+		return;
+	}
+	for ( Bitu i = 0; i < samples; i++ ) {
+		Skip();
+	}
+}
+
 Operator::Operator() {
 	chanData = 0;
 	freqMul = 0;
@@ -626,6 +676,26 @@ Operator::Operator() {
 	Channel
 */
 
+//Pick the block generator for a mode, specialized for the feedback and panning of the channel
+template<SynthMode mode>
+static SynthHandler BlockHandler( const Channel* chan ) {
+	Bit8u flags = 0;
+	if ( !( chan->regC0 & 0x0e ) )
+		flags |= BLOCK_NOFEEDBACK;
+	//Panning only applies to the OPL3 modes
+	if ( mode >= sm3AM && ( chan->regC0 & 0x30 ) == 0x30 )
+		flags |= BLOCK_CENTRE;
+	switch ( flags ) {
+	case BLOCK_NOFEEDBACK:
+		return &Channel::BlockTemplate< mode, BLOCK_NOFEEDBACK >;
+	case BLOCK_CENTRE:
+		return &Channel::BlockTemplate< mode, BLOCK_CENTRE >;
+	case BLOCK_NOFEEDBACK | BLOCK_CENTRE:
+		return &Channel::BlockTemplate< mode, BLOCK_NOFEEDBACK | BLOCK_CENTRE >;
+	}
+	return &Channel::BlockTemplate< mode, 0 >;
+}
+
 Channel::Channel() {
 	old[0] = old[1] = 0;
 	chanData = 0;
@@ -635,7 +705,8 @@ Channel::Channel() {
 	maskRight = -1;
 	feedback = 31;
 	fourMask = 0;
-	synthHandler = &Channel::BlockTemplate< sm2FM >;
+	freqDirty = false;
+	synthHandler = BlockHandler< sm2FM >( this );
 };
 
 void Channel::SetChanData( const Chip* chip, Bit32u data ) {
@@ -682,7 +753,8 @@ void Channel::WriteA0( const Chip* chip, Bit8u val ) {
 	Bit32u change = (chanData ^ val ) & 0xff;
 	if ( change ) {
 		chanData ^= change;
-		UpdateFrequency( chip, fourOp );
+		//A0 and B0 usually get written together, so update the operators once later
+		freqDirty = true;
 	}
 }
 
@@ -694,7 +766,7 @@ void Channel::WriteB0( const Chip* chip, Bit8u val ) {
 	Bitu change = (chanData ^ ( val << 8 ) ) & 0x1f00;
 	if ( change ) {
 		chanData ^= change;
-		UpdateFrequency( chip, fourOp );
+		freqDirty = true;
 	}
 	//Check for a change in the keyon/off state
 	if ( !(( val ^ regB0) & 0x20))
@@ -722,6 +794,7 @@ void Channel::WriteC0( const Chip* chip, Bit8u val ) {
 	if ( !change )
 		return;
 	regC0 = val;
+	PROBE3( channel__mode, chip, this - chip->chan, val );
 	feedback = ( val >> 1 ) & 7;
 	if ( feedback ) {
 		//We shift the input to the right 10 bit wave index value
@@ -746,16 +819,16 @@ void Channel::WriteC0( const Chip* chip, Bit8u val ) {
 			Bit8u synth = ( (chan0->regC0 & 1) << 0 )| (( chan1->regC0 & 1) << 1 );
 			switch ( synth ) {
 			case 0:
-				chan0->synthHandler = &Channel::BlockTemplate< sm3FMFM >;
+				chan0->synthHandler = BlockHandler< sm3FMFM >( chan0 );
 				break;
 			case 1:
-				chan0->synthHandler = &Channel::BlockTemplate< sm3AMFM >;
+				chan0->synthHandler = BlockHandler< sm3AMFM >( chan0 );
 				break;
 			case 2:
-				chan0->synthHandler = &Channel::BlockTemplate< sm3FMAM >;
+				chan0->synthHandler = BlockHandler< sm3FMAM >( chan0 );
 				break;
 			case 3:
-				chan0->synthHandler = &Channel::BlockTemplate< sm3AMAM >;
+				chan0->synthHandler = BlockHandler< sm3AMAM >( chan0 );
 				break;
 			}
 		//Disable updating percussion channels
@@ -763,9 +836,9 @@ void Channel::WriteC0( const Chip* chip, Bit8u val ) {
 
 		//Regular dual op, am or fm
 		} else if ( val & 1 ) {
-			synthHandler = &Channel::BlockTemplate< sm3AM >;
+			synthHandler = BlockHandler< sm3AM >( this );
 		} else {
-			synthHandler = &Channel::BlockTemplate< sm3FM >;
+			synthHandler = BlockHandler< sm3FM >( this );
 		}
 		maskLeft = ( val & 0x10 ) ? -1 : 0;
 		maskRight = ( val & 0x20 ) ? -1 : 0;
@@ -776,9 +849,9 @@ void Channel::WriteC0( const Chip* chip, Bit8u val ) {
 
 		//Regular dual op, am or fm
 		} else if ( val & 1 ) {
-			synthHandler = &Channel::BlockTemplate< sm2AM >;
+			synthHandler = BlockHandler< sm2AM >( this );
 		} else {
-			synthHandler = &Channel::BlockTemplate< sm2FM >;
+			synthHandler = BlockHandler< sm2FM >( this );
 		}
 	}
 }
@@ -789,101 +862,279 @@ void Channel::ResetC0( const Chip* chip ) {
 	WriteC0( chip, val );
 };
 
+//Mix a hi-hat, snare drum or top cymbal block, the wave index of each sample
+//is worked out up front as the phases of these voices come from the other ones
 template< bool opl3Mode>
-INLINE void Channel::GeneratePercussion( Chip* chip, Bit32s* output ) {
-	Channel* chan = this;
+static INLINE void PercussionVoice( Operator* op, const Bit16u* index, Bitu samples, Bit32s* output ) {
+	//Nothing to hear, only the envelope moves on
+	if ( !output ) {
+		if ( !op->EnvelopeStatic() ) {
+			for ( Bitu i = 0; i < samples; i++ ) {
+				op->ForwardVolume();
+			}
+		}
+		return;
+	}
+	if ( op->EnvelopeStatic() ) {
+		Bitu vol = op->ForwardVolume();
+		if ( ENV_SILENT( vol ) )
+			return;
+		for ( Bitu i = 0; i < samples; i++ ) {
+			Bit32s sample = op->GetWave( index[i], vol ) << 1;
+			if ( opl3Mode ) {
+				output[ i * 2 + 0 ] += sample;
+				output[ i * 2 + 1 ] += sample;
+			} else {
+				output[ i ] += sample;
+			}
+		}
+		return;
+	}
+	for ( Bitu i = 0; i < samples; i++ ) {
+		Bitu vol = op->ForwardVolume();
+		if ( ENV_SILENT( vol ) )
+			continue;
+		Bit32s sample = op->GetWave( index[i], vol ) << 1;
+		if ( opl3Mode ) {
+			output[ i * 2 + 0 ] += sample;
+			output[ i * 2 + 1 ] += sample;
+		} else {
+			output[ i ] += sample;
+		}
+	}
+}
+
+template< bool opl3Mode>
+void Channel::GeneratePercussion( Chip* chip, Bitu samples, Bit32s* output ) {
+	//Voices that are muted still run their envelopes and waves
+	Bit32u enabled = output ? chip->channelMask >> STEM_PERCUSSION : 0;
+	//Every voice into its own lane, or all of them mixed together
+	Bit32s* voice[5];
+	for ( Bitu v = 0; v < 5; v++ ) {
+		voice[v] = ( enabled & ( 1 << v ) ) ? output + v * chip->laneStride : 0;
+	}
+	const Bitu channels = opl3Mode ? 2 : 1;
 
 	//BassDrum
-	Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
-	old[0] = old[1];
-	old[1] = Op(0)->GetSample( mod ); 
+	for ( Bitu i = 0; i < samples; i++ ) {
+		Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
+		old[0] = old[1];
+		old[1] = Op(0)->GetSample( mod );
+		if ( !voice[0] )
+			continue;
+		//When bassdrum is in AM mode first operator is ignoed
+		Bit32s sample = Op(1)->GetSample( ( regC0 & 1 ) ? 0 : old[0] ) << 1;
+		if ( opl3Mode ) {
+			voice[0][ i * 2 + 0 ] += sample;
+			voice[0][ i * 2 + 1 ] += sample;
+		} else {
+			voice[0][ i ] += sample;
+		}
+	}
+	if ( !voice[0] ) {
+		Op(1)->Skip( samples );
+	}
 
-	//When bassdrum is in AM mode first operator is ignoed
-	if ( chan->regC0 & 1 ) {
-		mod = 0;
+	//Tom-tom
+	if ( voice[3] ) {
+		for ( Bitu i = 0; i < samples; i++ ) {
+			Bit32s sample = Op(4)->GetSample( 0 ) << 1;
+			if ( opl3Mode ) {
+				voice[3][ i * 2 + 0 ] += sample;
+				voice[3][ i * 2 + 1 ] += sample;
+			} else {
+				voice[3][ i ] += sample;
+			}
+		}
 	} else {
-		mod = old[0];
+		Op(4)->Skip( samples );
+	}
+
+	//Hi-Hat, Snare Drum and Top-Cymbal share the phase bits of the hi-hat and cymbal waves
+	Bit8u noiseBits[ PERCUSSION_BLOCK ];
+	Bit16u hhIndex[ PERCUSSION_BLOCK ];
+	Bit16u sdIndex[ PERCUSSION_BLOCK ];
+	Bit16u tcIndex[ PERCUSSION_BLOCK ];
+	Operator* hh = Op(2);
+	Operator* tc = Op(5);
+	for ( Bitu done = 0; done < samples; ) {
+		Bit32u todo = samples - done;
+		if ( todo > PERCUSSION_BLOCK )
+			todo = PERCUSSION_BLOCK;
+		chip->ForwardNoise( todo, noiseBits );
+		//The waves move on at a fixed rate during the block, so every sample can
+		//be done at once
+		const Bit32u hhStart = hh->waveIndex, hhAdd = hh->waveCurrent;
+		const Bit32u tcStart = tc->waveIndex, tcAdd = tc->waveCurrent;
+		for ( Bit32u i = 0; i < todo; i++ ) {
+			Bit32u noiseBit = noiseBits[i];
+			Bit32u c2 = ( hhStart + ( i + 1 ) * hhAdd ) >> WAVE_SH;
+			Bit32u c5 = ( tcStart + ( i + 1 ) * tcAdd ) >> WAVE_SH;
+			Bit32u phaseBit = (((c2 & 0x88) ^ ((c2<<5) & 0x80)) | ((c5 ^ (c5<<2)) & 0x20)) ? 0x02 : 0x00;
+			//0x34 << ( phaseBit ^ (noiseBit << 1 ) ), which only ever shifts by 0 or 2
+			hhIndex[i] = (phaseBit<<8) | ( ( phaseBit ^ (noiseBit << 1) ) ? 0xd0 : 0x34 );
+			sdIndex[i] = ( 0x100 + (c2 & 0x100) ) ^ ( noiseBit << 8 );
+			tcIndex[i] = (1 + phaseBit) << 8;
+		}
+		hh->waveIndex = hhStart + todo * hhAdd;
+		tc->waveIndex = tcStart + todo * tcAdd;
+
+		Bitu offset = done * channels;
+		PercussionVoice<opl3Mode>( hh, hhIndex, todo, voice[1] ? voice[1] + offset : 0 );
+		PercussionVoice<opl3Mode>( Op(3), sdIndex, todo, voice[2] ? voice[2] + offset : 0 );
+		PercussionVoice<opl3Mode>( tc, tcIndex, todo, voice[4] ? voice[4] + offset : 0 );
+		done += todo;
 	}
-	Bit32s sample = Op(1)->GetSample( mod ); 
+}
 
+//Get a sample from an operator, with a static envelope its wave index and volume are kept in locals
+#define BLOCK_SAMPLE( _OP_, _MOD_ ) ( ( flags & BLOCK_STATIC ) ? \
+	StaticSample( Op( _OP_ ), index[ _OP_ ], add[ _OP_ ], volume[ _OP_ ], (_MOD_) ) : Op( _OP_ )->GetSample( (_MOD_) ) )
 
-	//Precalculate stuff used by other outputs
-	Bit32u noiseBit = chip->ForwardNoise() & 0x1;
-	Bit32u c2 = Op(2)->ForwardWave();
-	Bit32u c5 = Op(5)->ForwardWave();
-	Bit32u phaseBit = (((c2 & 0x88) ^ ((c2<<5) & 0x80)) | ((c5 ^ (c5<<2)) & 0x20)) ? 0x02 : 0x00;
+//Operator::GetSample() without touching the operator, so the compiler can keep the state in registers
+static INLINE Bits StaticSample( Operator* op, Bit32u& index, Bit32u add, Bitu vol, Bits modulation ) {
+	index += add;
+	if ( ENV_SILENT( vol ) )
+		return 0;
+	return op->GetWave( ( index >> WAVE_SH ) + modulation, vol );
+}
 
-	//Hi-Hat
-	Bit32u hhVol = Op(2)->ForwardVolume();
-	if ( !ENV_SILENT( hhVol ) ) {
-		Bit32u hhIndex = (phaseBit<<8) | (0x34 << ( phaseBit ^ (noiseBit << 1 )));
-		sample += Op(2)->GetWave( hhIndex, hhVol );
+template<SynthMode mode, Bit8u flags>
+void Channel::BlockLoop( Bit32u samples, Bit32s* output, const Bitu* vol ) {
+	//Without feedback the shift is a constant
+	const Bit8u shift = ( flags & BLOCK_NOFEEDBACK ) ? 31 : feedback;
+	const Bitu ops = ( mode > sm4Start ) ? 4 : 2;
+	//Copies of the state, stores to the output could otherwise alias them
+	Bit32s old0 = old[0];
+	Bit32s old1 = old[1];
+	Bit32u index[ 4 ], add[ 4 ];
+	Bitu volume[ 4 ];
+	if ( flags & BLOCK_STATIC ) {
+		for ( Bitu op = 0; op < ops; op++ ) {
+			index[ op ] = Op( op )->waveIndex;
+			add[ op ] = Op( op )->waveCurrent;
+			volume[ op ] = vol[ op ];
+		}
 	}
-	//Snare Drum
-	Bit32u sdVol = Op(3)->ForwardVolume();
-	if ( !ENV_SILENT( sdVol ) ) {
-		Bit32u sdIndex = ( 0x100 + (c2 & 0x100) ) ^ ( noiseBit << 8 );
-		sample += Op(3)->GetWave( sdIndex, sdVol );
+	for ( Bitu i = 0; i < samples; i++ ) {
+		//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
+		Bit32s mod = (Bit32u)((old0 + old1)) >> shift;
+		old0 = old1;
+		old1 = BLOCK_SAMPLE( 0, mod );
+		Bit32s sample = 0;
+		Bit32s out0 = old0;
+		if ( mode == sm2AM || mode == sm3AM ) {
+			sample = out0 + BLOCK_SAMPLE( 1, 0 );
+		} else if ( mode == sm2FM || mode == sm3FM ) {
+			sample = BLOCK_SAMPLE( 1, out0 );
+		} else if ( mode == sm3FMFM ) {
+			Bits next = BLOCK_SAMPLE( 1, out0 ); 
+			next = BLOCK_SAMPLE( 2, next );
+			sample = BLOCK_SAMPLE( 3, next );
+		} else if ( mode == sm3AMFM ) {
+			sample = out0;
+			Bits next = BLOCK_SAMPLE( 1, 0 ); 
+			next = BLOCK_SAMPLE( 2, next );
+			sample += BLOCK_SAMPLE( 3, next );
+		} else if ( mode == sm3FMAM ) {
+			sample = BLOCK_SAMPLE( 1, out0 );
+			Bits next = BLOCK_SAMPLE( 2, 0 );
+			sample += BLOCK_SAMPLE( 3, next );
+		} else if ( mode == sm3AMAM ) {
+			sample = out0;
+			Bits next = BLOCK_SAMPLE( 1, 0 ); 
+			sample += BLOCK_SAMPLE( 2, next );
+			sample += BLOCK_SAMPLE( 3, 0 );
+		}
+		switch( mode ) {
+		case sm2AM:
+		case sm2FM:
+			output[ i ] += sample;
+			break;
+		case sm3AM:
+		case sm3FM:
+		case sm3FMFM:
+		case sm3AMFM:
+		case sm3FMAM:
+		case sm3AMAM:
+			if ( flags & BLOCK_CENTRE ) {
+				output[ i * 2 + 0 ] += sample;
+				output[ i * 2 + 1 ] += sample;
+			} else {
+				output[ i * 2 + 0 ] += sample & maskLeft;
+				output[ i * 2 + 1 ] += sample & maskRight;
+			}
+			break;
+		default:
+			break;
+		}
 	}
-	//Tom-tom
-	sample += Op(4)->GetSample( 0 );
-
-	//Top-Cymbal
-	Bit32u tcVol = Op(5)->ForwardVolume();
-	if ( !ENV_SILENT( tcVol ) ) {
-		Bit32u tcIndex = (1 + phaseBit) << 8;
-		sample += Op(5)->GetWave( tcIndex, tcVol );
-	}
-	sample <<= 1;
-	if ( opl3Mode ) {
-		output[0] += sample;
-		output[1] += sample;
-	} else {
-		output[0] += sample;
+	old[0] = old0;
+	old[1] = old1;
+	if ( flags & BLOCK_STATIC ) {
+		for ( Bitu op = 0; op < ops; op++ ) {
+			Op( op )->waveIndex = index[ op ];
+		}
 	}
 }
 
-template<SynthMode mode>
+#undef BLOCK_SAMPLE
+
+template<SynthMode mode, Bit8u flags>
 Channel* Channel::BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output ) {
+	//Channels 7 and 8 keep their handler through percussion mode while their feedback and panning change
+	if ( mode < sm4Start ) {
+		Bit8u current = ( regC0 & 0x0e ) ? 0 : BLOCK_NOFEEDBACK;
+		if ( mode >= sm3AM && ( regC0 & 0x30 ) == 0x30 )
+			current |= BLOCK_CENTRE;
+		if ( GCC_UNLIKELY( current != flags ) ) {
+			synthHandler = BlockHandler< mode >( this );
+			return (this->*synthHandler)( chip, samples, output );
+		}
+	}
+	//Without feedback the shift is a constant
+	const Bit8u shift = ( flags & BLOCK_NOFEEDBACK ) ? 31 : feedback;
 	switch( mode ) {
 	case sm2AM:
 	case sm3AM:
-		if ( Op(0)->Silent() && Op(1)->Silent() ) {
+		if ( Op(0)->Skippable( chip ) && Op(1)->Skippable( chip ) ) {
 			old[0] = old[1] = 0;
 			return (this + 1);
 		}
 		break;
 	case sm2FM:
 	case sm3FM:
-		if ( Op(1)->Silent() ) {
+		if ( Op(1)->Skippable( chip ) ) {
 			old[0] = old[1] = 0;
 			return (this + 1);
 		}
 		break;
 	case sm3FMFM:
-		if ( Op(3)->Silent() ) {
+		if ( Op(3)->Skippable( chip ) ) {
 			old[0] = old[1] = 0;
 			return (this + 2);
 		}
 		break;
 	case sm3AMFM:
-		if ( Op(0)->Silent() && Op(3)->Silent() ) {
+		if ( Op(0)->Skippable( chip ) && Op(3)->Skippable( chip ) ) {
 			old[0] = old[1] = 0;
 			return (this + 2);
 		}
 		break;
 	case sm3FMAM:
-		if ( Op(1)->Silent() && Op(3)->Silent() ) {
+		if ( Op(1)->Skippable( chip ) && Op(3)->Skippable( chip ) ) {
 			old[0] = old[1] = 0;
 			return (this + 2);
 		}
 		break;
 	case sm3AMAM:
-		if ( Op(0)->Silent() && Op(2)->Silent() && Op(3)->Silent() ) {
+		if ( Op(0)->Skippable( chip ) && Op(2)->Skippable( chip ) && Op(3)->Skippable( chip ) ) {
 			old[0] = old[1] = 0;
 			return (this + 2);
 		}
 		break;
+	default:
+		break;
 	}
 	//Init the operators with the the current vibrato and tremolo values
 	Op( 0 )->Prepare( chip );
@@ -896,60 +1147,61 @@ Channel* Channel::BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output ) {
 		Op( 4 )->Prepare( chip );
 		Op( 5 )->Prepare( chip );
 	}
-	for ( Bitu i = 0; i < samples; i++ ) {
-		//Early out for percussion handlers
-		if ( mode == sm2Percussion ) {
-			GeneratePercussion<false>( chip, output + i );
-			continue;	//Prevent some unitialized value bitching
-		} else if ( mode == sm3Percussion ) {
-			GeneratePercussion<true>( chip, output + i * 2 );
-			continue;	//Prevent some unitialized value bitching
-		}
-
-		//Do unsigned shift so we can shift out all bits but still stay in 10 bit range otherwise
-		Bit32s mod = (Bit32u)((old[0] + old[1])) >> feedback;
-		old[0] = old[1];
-		old[1] = Op(0)->GetSample( mod );
-		Bit32s sample;
-		Bit32s out0 = old[0];
-		if ( mode == sm2AM || mode == sm3AM ) {
-			sample = out0 + Op(1)->GetSample( 0 );
-		} else if ( mode == sm2FM || mode == sm3FM ) {
-			sample = Op(1)->GetSample( out0 );
-		} else if ( mode == sm3FMFM ) {
-			Bits next = Op(1)->GetSample( out0 ); 
-			next = Op(2)->GetSample( next );
-			sample = Op(3)->GetSample( next );
-		} else if ( mode == sm3AMFM ) {
-			sample = out0;
-			Bits next = Op(1)->GetSample( 0 ); 
-			next = Op(2)->GetSample( next );
-			sample += Op(3)->GetSample( next );
-		} else if ( mode == sm3FMAM ) {
-			sample = Op(1)->GetSample( out0 );
-			Bits next = Op(2)->GetSample( 0 );
-			sample += Op(3)->GetSample( next );
-		} else if ( mode == sm3AMAM ) {
-			sample = out0;
-			Bits next = Op(1)->GetSample( 0 ); 
-			sample += Op(2)->GetSample( next );
-			sample += Op(3)->GetSample( 0 );
+	//Percussion generates each of its voices for the whole block
+	if ( mode == sm2Percussion ) {
+		GeneratePercussion<false>( chip, samples, output );
+		return( this + 3 );
+	} else if ( mode == sm3Percussion ) {
+		GeneratePercussion<true>( chip, samples, output );
+		return( this + 3 );
+	}
+	//Muted channels keep running so unmuting them sounds like they never stopped
+	if ( GCC_UNLIKELY( !output ) && mode < sm6Start ) {
+		//The first operator's output is still needed for the feedback
+		Operator* op0 = Op(0);
+		if ( op0->EnvelopeStatic() ) {
+			Bitu vol = op0->ForwardVolume();
+			if ( ENV_SILENT( vol ) ) {
+				op0->waveIndex += op0->waveCurrent * samples;
+				old[0] = samples > 1 ? 0 : old[1];
+				old[1] = 0;
+			} else for ( Bitu i = 0; i < samples; i++ ) {
+				Bit32s mod = (Bit32u)((old[0] + old[1])) >> shift;
+				old[0] = old[1];
+				old[1] = op0->GetWave( op0->ForwardWave() + mod, vol );
+			}
+		} else for ( Bitu i = 0; i < samples; i++ ) {
+			Bit32s mod = (Bit32u)((old[0] + old[1])) >> shift;
+			old[0] = old[1];
+			old[1] = op0->GetSample( mod );
 		}
-		switch( mode ) {
-		case sm2AM:
-		case sm2FM:
-			output[ i ] += sample;
-			break;
-		case sm3AM:
-		case sm3FM:
-		case sm3FMFM:
-		case sm3AMFM:
-		case sm3FMAM:
-		case sm3AMAM:
-			output[ i * 2 + 0 ] += sample & maskLeft;
-			output[ i * 2 + 1 ] += sample & maskRight;
-			break;
+		Op(1)->Skip( samples );
+		if ( mode > sm4Start ) {
+			Op(2)->Skip( samples );
+			Op(3)->Skip( samples );
 		}
+		samples = 0;
+	}
+	//Envelopes that can't change during the block leave the volume out of the loop
+	const Bitu ops = ( mode > sm4Start ) ? 4 : 2;
+	Bitu vol[ 4 ];
+	Bitu op = 0;
+	while ( op < ops && Op( op )->EnvelopeStatic() ) {
+		vol[ op ] = Op( op )->ForwardVolume();
+		op++;
+	}
+#ifdef LANES_AVX2
+	//Generated later in lockstep with other channels
+	if ( chip->lanes && output && mode < sm4Start ) {
+		chip->lanes->Add( this, samples, output, mode == sm3AM || mode == sm3FM, mode == sm2AM || mode == sm3AM,
+			op == ops ? &Channel::BlockLoop< mode, flags | BLOCK_STATIC > : &Channel::BlockLoop< mode, flags > );
+		return ( this + 1 );
+	}
+#endif
+	if ( op == ops ) {
+		BlockLoop< mode, flags | BLOCK_STATIC >( samples, output, vol );
+	} else {
+		BlockLoop< mode, flags >( samples, output, vol );
 	}
 	switch( mode ) {
 	case sm2AM:
@@ -979,18 +1231,95 @@ Chip::Chip() {
 	regBD = 0;
 	reg104 = 0;
 	opl3Active = 0;
+	waveFormMask = 0;
+	previewLimit = 0;
+	lanes = 0;
+	laneStride = 0;
+	channelMask = ( 1 << STEM_LANES ) - 1;
+	groupMask = ( 1 << 18 ) - 1;
+	memset( regShadow, 0, sizeof( regShadow ) );
+	fourOpSeen = false;
+	freqDirty = false;
+}
+
+void Chip::UpdateChannels() {
+	freqDirty = false;
+	for ( int i = 0; i < 18; i++ ) {
+		if ( !chan[i].freqDirty )
+			continue;
+		chan[i].freqDirty = false;
+		//Any change to 4-op mode updates the channels first, so this is the same as at write time
+		Bit8u fourOp = reg104 & opl3Active & chan[i].fourMask;
+		chan[i].UpdateFrequency( this, fourOp );
+	}
+}
+
+INLINE Bit32s* Chip::ChannelOutput( Channel* ch, Bit32s* output ) {
+	if ( !laneStride )
+		return output;
+	Bitu lane = ch - chan;
+	//The percussion channel handles all voices starting at their first lane
+	if ( lane == 6 && ( regBD & 0x20 ) )
+		lane = STEM_PERCUSSION;
+	return output + lane * laneStride;
+}
+
+INLINE bool Chip::ChannelEnabled( Channel* ch ) const {
+	Bitu index = ch - chan;
+	//The percussion channel only stops when all its voices are muted
+	if ( index == 6 && ( regBD & 0x20 ) )
+		return ( channelMask >> STEM_PERCUSSION ) & 0x1f;
+	return ( channelMask >> index ) & 1;
+}
+
+INLINE void Chip::ClearOutput( Bit32s* output, Bitu size ) {
+	if ( !laneStride ) {
+		memset(output, 0, sizeof(Bit32s) * size);
+		return;
+	}
+	for ( Bitu lane = 0; lane < STEM_LANES; lane++ ) {
+		memset(output + lane * laneStride, 0, sizeof(Bit32s) * size);
+	}
 }
 
-INLINE Bit32u Chip::ForwardNoise() {
-	noiseCounter += noiseAdd;
-	Bitu count = noiseCounter >> LFO_SH;
-	noiseCounter &= WAVE_MASK;
-	for ( ; count > 0; --count ) {
-		//Noise calculation from mame
-		noiseValue ^= ( 0x800302 ) & ( 0 - (noiseValue & 1 ) );
-		noiseValue >>= 1;
+//Noise calculation from mame, shifting right and xoring in 0x800302 >> 1
+//whenever a 1 falls out.  The taps below bit 8 are only bit 0, so for the
+//next 8 steps the bit falling out is just the running parity of the low bits.
+static INLINE Bit32u NoiseAhead( Bit32u value ) {
+	Bit32u bits = value & 0xff;
+	bits ^= bits << 1;
+	bits ^= bits << 2;
+	bits ^= bits << 4;
+	return bits & 0xff;
+}
+
+//Take up to 8 steps at once, with the bits NoiseAhead() returned for the value
+static INLINE Bit32u NoiseJump( Bit32u value, Bit32u ahead, Bitu steps ) {
+	if ( !steps )
+		return value;
+	ahead &= ( 1 << steps ) - 1;
+	//Every 1 that fell out xored in the taps, which then moved down with the rest
+	Bit32u taps = ahead ^ ( ahead << 7 ) ^ ( ahead << 8 ) ^ ( ahead << 22 );
+	return ( value >> steps ) ^ ( taps >> ( steps - 1 ) );
+}
+
+INLINE void Chip::ForwardNoise( Bitu samples, Bit8u* bits ) {
+	Bit32u value = noiseValue;
+	Bit32u ahead = NoiseAhead( value );
+	//Steps taken since value
+	Bitu steps = 0;
+	for ( Bitu i = 0; i < samples; i++ ) {
+		noiseCounter += noiseAdd;
+		steps += noiseCounter >> LFO_SH;
+		noiseCounter &= WAVE_MASK;
+		while ( GCC_UNLIKELY( steps >= 8 ) ) {
+			value = NoiseJump( value, ahead, 8 );
+			ahead = NoiseAhead( value );
+			steps -= 8;
+		}
+		bits[i] = ( ahead >> steps ) & 1;
 	}
-	return noiseValue;
+	noiseValue = NoiseJump( value, ahead, steps );
 }
 
 INLINE Bit32u Chip::ForwardLFO( Bit32u samples ) {
@@ -1006,6 +1335,7 @@ INLINE Bit32u Chip::ForwardLFO( Bit32u samples ) {
 		count = samples;
 		lfoCounter += count * lfoAdd;
 	} else {
+		PROBE3( lfo__split, this, count, samples );
 		lfoCounter += count * lfoAdd;
 		lfoCounter &= (LFO_MAX - 1);
 		//Maximum of 7 vibrato value * 4
@@ -1019,6 +1349,65 @@ INLINE Bit32u Chip::ForwardLFO( Bit32u samples ) {
 	return count;
 }
 
+INLINE Bitu Chip::ScheduleLFO( Bitu total, LFOSegment* schedule, Bitu* samples ) {
+	Bitu segments = 0;
+	*samples = 0;
+	while ( total > 0 && segments < LFO_SCHEDULE ) {
+		Bit32u count = ForwardLFO( total );
+		LFOSegment& seg = schedule[ segments++ ];
+		seg.samples = count;
+		seg.tremoloValue = tremoloValue;
+		seg.vibratoSign = vibratoSign;
+		seg.vibratoShift = vibratoShift;
+		total -= count;
+		*samples += count;
+	}
+	return segments;
+}
+
+INLINE bool Chip::ChannelSinglePass( const Channel* ch ) const {
+	//Operators of the channels the handler generates together
+	//A 0x104 write only switches the handler on the next 0xc0 write, so any pair that can run 4op counts as one
+	Bitu count = 1;
+	if ( ch == chan + 6 && ( regBD & 0x20 ) )
+		count = 3;
+	else if ( opl3Active && ( ch->fourMask & 0x3f ) && !( ch->fourMask & 0x80 ) )
+		count = 2;
+	for ( Bitu i = 0; i < count * 2; i++ ) {
+		const Operator& op = ch[ i >> 1 ].op[ i & 1 ];
+		if ( op.tremoloMask || op.vibStrength )
+			return false;
+		//The handler checks for silence each time it runs, which has to stay at the LFO steps while it can change
+		if ( !op.EnvelopeStatic() )
+			return false;
+	}
+	return true;
+}
+
+INLINE Channel* Chip::GenerateChannel( Channel* ch, Bitu samples, const LFOSegment* schedule, Bitu segments, Bit32s* output, Bitu channels ) {
+	//Without tremolo, vibrato or a moving envelope nothing changes at the LFO steps, so do the whole block at once
+	if ( segments == 1 || ChannelSinglePass( ch ) ) {
+		tremoloValue = schedule[0].tremoloValue;
+		vibratoSign = schedule[0].vibratoSign;
+		vibratoShift = schedule[0].vibratoShift;
+		return (ch->*(ch->synthHandler))( this, samples, output );
+	}
+	//A lane holds the whole block, so the segments are generated straight away
+	Lanes* queue = lanes;
+	lanes = 0;
+	Channel* next = ch;
+	for ( Bitu s = 0; s < segments; s++ ) {
+		tremoloValue = schedule[s].tremoloValue;
+		vibratoSign = schedule[s].vibratoSign;
+		vibratoShift = schedule[s].vibratoShift;
+		next = (ch->*(ch->synthHandler))( this, schedule[s].samples, output );
+		if ( output )
+			output += schedule[s].samples * channels;
+	}
+	lanes = queue;
+	return next;
+}
+
 
 void Chip::WriteBD( Bit8u val ) {
 	Bit8u change = regBD ^ val;
@@ -1032,9 +1421,9 @@ void Chip::WriteBD( Bit8u val ) {
 		//Drum was just enabled, make sure channel 6 has the right synth
 		if ( change & 0x20 ) {
 			if ( opl3Active ) {
-				chan[6].synthHandler = &Channel::BlockTemplate< sm3Percussion >; 
+				chan[6].synthHandler = &Channel::BlockTemplate< sm3Percussion, 0 >;
 			} else {
-				chan[6].synthHandler = &Channel::BlockTemplate< sm2Percussion >; 
+				chan[6].synthHandler = &Channel::BlockTemplate< sm2Percussion, 0 >;
 			}
 		}
 		//Bass Drum
@@ -1099,6 +1488,20 @@ void Chip::WriteBD( Bit8u val ) {
 
 void Chip::WriteReg( Bit32u reg, Bit8u val ) {
 	Bitu index;
+	PROBE3( write__reg, this, reg, val );
+	//Drop writes that wouldn't change anything, the chip ignores them anyway
+	if ( regShadow[ reg & 0x1ff ] == val ) {
+		//Writes to the 2nd channel of a 4-op pair are ignored, so the shadow might not match the chip
+		if ( !fourOpSeen || ( reg & 0xe0 ) != 0xa0 || ( reg & 0xff ) == 0xbd )
+			return;
+	}
+	regShadow[ reg & 0x1ff ] = val;
+	//Frequency updates wait until the channel writes are done
+	if ( ( reg & 0xe0 ) == 0xa0 && ( reg & 0xff ) != 0xbd ) {
+		freqDirty = true;
+	} else if ( freqDirty ) {
+		UpdateChannels();
+	}
 	switch ( (reg & 0xf0) >> 4 ) {
 	case 0x00 >> 4:
 		if ( reg == 0x01 ) {
@@ -1109,11 +1512,13 @@ void Chip::WriteReg( Bit32u reg, Bit8u val ) {
 				return;
 			//Always keep the highest bit enabled, for checking > 0x80
 			reg104 = 0x80 | ( val & 0x3f );
+			fourOpSeen |= ( reg104 & opl3Active & 0x3f ) != 0;
 		} else if ( reg == 0x105 ) {
 			//MAME says the real opl3 doesn't reset anything on opl3 disable/enable till the next write in another register
 			if ( !((opl3Active ^ val) & 1 ) )
 				return;
 			opl3Active = ( val & 1 ) ? 0xff : 0;
+			fourOpSeen |= ( reg104 & opl3Active & 0x3f ) != 0;
 			//Update the 0xc0 register for all channels to signal the switch to mono/stereo handlers
 			for ( int i = 0; i < 18;i++ ) {
 				chan[i].ResetC0( this );
@@ -1160,6 +1565,9 @@ void Chip::WriteReg( Bit32u reg, Bit8u val ) {
 	}
 }
 
+Bit8u Chip::ReadReg( Bit32u reg ) const {
+	return regShadow[ reg & 0x1ff ];
+}
 
 Bit32u Chip::WriteAddr( Bit32u port, Bit8u val ) {
 	switch ( port & 3 ) {
@@ -1175,49 +1583,60 @@ Bit32u Chip::WriteAddr( Bit32u port, Bit8u val ) {
 }
 
 void Chip::GenerateBlock2( Bitu total, Bit32s* output ) {
+	if ( freqDirty )
+		UpdateChannels();
+	LFOSegment schedule[ LFO_SCHEDULE ];
 	while ( total > 0 ) {
-		Bit32u samples = ForwardLFO( total );
-		memset(output, 0, sizeof(Bit32s) * samples);
-		int count = 0;
+		Bitu samples;
+		Bitu segments = ScheduleLFO( total, schedule, &samples );
+		ClearOutput( output, samples );
 		for( Channel* ch = chan; ch < chan + 9; ) {
-			count++;
-			ch = (ch->*(ch->synthHandler))( this, samples, output );
+			//Left for another copy of the chip
+			if ( !( ( groupMask >> ( ch - chan ) ) & 1 ) ) {
+				ch++;
+				continue;
+			}
+			Bit32s* out = ChannelEnabled( ch ) ? ChannelOutput( ch, output ) : 0;
+			ch = GenerateChannel( ch, samples, schedule, segments, out, 1 );
 		}
 		total -= samples;
+		//Queued channels have to catch up before the next part of the block
+		if ( lanes && total )
+			lanes->Flush();
 		output += samples;
 	}
 }
 
 void Chip::GenerateBlock3( Bitu total, Bit32s* output  ) {
+	if ( freqDirty )
+		UpdateChannels();
+	LFOSegment schedule[ LFO_SCHEDULE ];
 	while ( total > 0 ) {
-		Bit32u samples = ForwardLFO( total );
-		memset(output, 0, sizeof(Bit32s) * samples *2);
-		int count = 0;
+		Bitu samples;
+		Bitu segments = ScheduleLFO( total, schedule, &samples );
+		ClearOutput( output, samples * 2 );
 		for( Channel* ch = chan; ch < chan + 18; ) {
-			count++;
-			ch = (ch->*(ch->synthHandler))( this, samples, output );
+			//Left for another copy of the chip
+			if ( !( ( groupMask >> ( ch - chan ) ) & 1 ) ) {
+				ch++;
+				continue;
+			}
+			Bit32s* out = ChannelEnabled( ch ) ? ChannelOutput( ch, output ) : 0;
+			ch = GenerateChannel( ch, samples, schedule, segments, out, 2 );
 		}
 		total -= samples;
+		//Queued channels have to catch up before the next part of the block
+		if ( lanes && total )
+			lanes->Flush();
 		output += samples * 2;
 	}
 }
 
-void Chip::Setup( Bit32u rate ) {
+void RateTables::Setup( Bit32u rate ) {
 	double original = OPLRATE;
 //	double original = rate;
 	double scale = original / (double)rate;
 
-	//Noise counter is run at the same precision as general waves
-	noiseAdd = (Bit32u)( 0.5 + scale * ( 1 << LFO_SH ) );
-	noiseCounter = 0;
-	noiseValue = 1;	//Make sure it triggers the noise xor the first time
-	//The low frequency oscillation counter
-	//Every time his overflows vibrato and tremoloindex are increased
-	lfoAdd = (Bit32u)( 0.5 + scale * ( 1 << LFO_SH ) );
-	lfoCounter = 0;
-	vibratoIndex = 0;
-	tremoloIndex = 0;
-
 	//With higher octave this gets shifted up
 	//-1 since the freqCreateTable = *2
 #ifdef WAVE_PRECISION
@@ -1289,6 +1708,53 @@ void Chip::Setup( Bit32u rate ) {
 		//This should provide instant volume maximizing
 		attackRates[i] = 8 << RATE_SH;
 	}
+}
+
+//A reset chip for each rate in use, never freed since there are only ever a few rates
+struct ChipTemplate {
+	Bit32u rate;
+	RateTables tables;
+	Chip chip;
+	ChipTemplate* next;
+};
+static ChipTemplate* chipTemplates = 0;
+static std::mutex chipTemplateMutex;
+
+void Chip::Setup( Bit32u rate ) {
+	std::lock_guard< std::mutex > lock( chipTemplateMutex );
+	ChipTemplate* tmpl;
+	for ( tmpl = chipTemplates; tmpl; tmpl = tmpl->next ) {
+		if ( tmpl->rate == rate )
+			break;
+	}
+	if ( !tmpl ) {
+		tmpl = new ChipTemplate();
+		tmpl->rate = rate;
+		tmpl->tables.Setup( rate );
+		tmpl->chip.Reset( rate, &tmpl->tables );
+		tmpl->next = chipTemplates;
+		chipTemplates = tmpl;
+	}
+	*this = tmpl->chip;
+}
+
+void Chip::Reset( Bit32u rate, const RateTables* tables ) {
+	double original = OPLRATE;
+//	double original = rate;
+	double scale = original / (double)rate;
+
+	rates = tables;
+	//Noise counter is run at the same precision as general waves
+	noiseAdd = (Bit32u)( 0.5 + scale * ( 1 << LFO_SH ) );
+	noiseCounter = 0;
+	noiseValue = 1;	//Make sure it triggers the noise xor the first time
+	//The low frequency oscillation counter
+	//Every time his overflows vibrato and tremoloindex are increased
+	lfoAdd = (Bit32u)( 0.5 + scale * ( 1 << LFO_SH ) );
+	lfoCounter = 0;
+	vibratoIndex = 0;
+	tremoloIndex = 0;
+
 	//Setup the channels with the correct four op flags
 	//Channels are accessed through a table so they appear linear here
 	chan[ 0].fourMask = 0x00 | ( 1 << 0 );
@@ -1324,188 +1790,370 @@ void Chip::Setup( Bit32u rate ) {
 		WriteReg( i, 0xff );
 		WriteReg( i, 0x0 );
 	}
+	//4-op mode was only on while its own register was being cleared, the shadow still matches the chip
+	fourOpSeen = false;
 }
 
-static bool doneTables = false;
-void InitTables( void ) {
-	if ( doneTables )
+Bit32u Handler::WriteAddr( Bit32u port, Bit8u val ) {
+	return chip.WriteAddr( port, val );
+
+}
+void Handler::WriteReg( Bit32u addr, Bit8u val ) {
+	chip.WriteReg( addr, val );
+}
+
+void Handler::GenerateOutput( Bit32s* output, Bitu samples, Bitu lanes, Lanes* queue ) {
+	const Bitu channels = chip.opl3Active ? 2 : 1;
+	if ( !previewShift ) {
+		chip.laneStride = lanes > 1 ? samples * channels : 0;
+		chip.lanes = queue;
+		if ( channels == 1 )
+			chip.GenerateBlock2( samples, output );
+		else
+			chip.GenerateBlock3( samples, output );
+		chip.lanes = 0;
+		chip.laneStride = 0;
 		return;
-	doneTables = true;
-#if ( DBOPL_WAVE == WAVE_HANDLER ) || ( DBOPL_WAVE == WAVE_TABLELOG )
-	//Exponential volume table, same as the real adlib
-	for ( int i = 0; i < 256; i++ ) {
-		//Save them in reverse
-		ExpTable[i] = (int)( 0.5 + ( pow(2.0, ( 255 - i) * ( 1.0 /256 ) )-1) * 1024 );
-		ExpTable[i] += 1024; //or remove the -1 oh well :)
-		//Preshift to the left once so the final volume can shift to the right
-		ExpTable[i] *= 2;
 	}
-#endif
-#if ( DBOPL_WAVE == WAVE_HANDLER )
-	//Add 0.5 for the trunc rounding of the integer cast
-	//Do a PI sinetable instead of the original 0.5 PI
-	for ( int i = 0; i < 512; i++ ) {
-		SinTable[i] = (Bit16s)( 0.5 - log10( sin( (i + 0.5) * (PI / 512.0) ) ) / log10(2.0)*256 );
+	//Chip samples needed on top of what's left between the last two
+	const Bitu factor = 1 << previewShift;
+	const Bitu left = factor - previewPhase;
+	Bitu frames = samples > left ? ( samples - left + factor - 1 ) >> previewShift : 0;
+	if ( frames ) {
+		if ( !previewBuffer ) {
+			previewBuffer = new Bit32s[ STEM_LANES * 512 * 2 ];
+		}
+		chip.laneStride = lanes > 1 ? frames * channels : 0;
+		chip.lanes = queue;
+		if ( channels == 1 )
+			chip.GenerateBlock2( frames, previewBuffer );
+		else
+			chip.GenerateBlock3( frames, previewBuffer );
+		chip.lanes = 0;
+		chip.laneStride = 0;
+		//The interpolation needs the samples now
+		if ( queue )
+			queue->Flush();
+	}
+	//Straight lines between the chip samples, one chip sample behind
+	Bitu phase = previewPhase;
+	for ( Bitu lane = 0; lane < lanes; lane++ ) {
+		for ( Bitu side = 0; side < channels; side++ ) {
+			const Bit32s* in = previewBuffer + lane * frames * channels + side;
+			Bit32s* out = output + lane * samples * channels + side;
+			Bit32s last = previewLast[ lane * 2 + side ];
+			Bit32s next = previewNext[ lane * 2 + side ];
+			phase = previewPhase;
+			for ( Bitu i = 0; i < samples; ) {
+				if ( phase == factor ) {
+					last = next;
+					next = *in;
+					in += channels;
+					phase = 0;
+				}
+				Bitu run = factor - phase;
+				if ( run > samples - i )
+					run = samples - i;
+				const Bit32s diff = next - last;
+				for ( Bitu r = 0; r < run; r++ ) {
+					out[ ( i + r ) * channels ] = last + ( ( diff * (Bit32s)( phase + r ) ) >> previewShift );
+				}
+				i += run;
+				phase += run;
+			}
+			previewLast[ lane * 2 + side ] = last;
+			previewNext[ lane * 2 + side ] = next;
+		}
+		//Keep the right side going too, so switching to OPL3 doesn't jump
+		if ( channels == 1 ) {
+			previewLast[ lane * 2 + 1 ] = previewLast[ lane * 2 ];
+			previewNext[ lane * 2 + 1 ] = previewNext[ lane * 2 ];
+		}
 	}
-#endif
-#if ( DBOPL_WAVE == WAVE_TABLEMUL )
-	//Multiplication based tables
-	for ( int i = 0; i < 384; i++ ) {
-		int s = i * 8;
-		//TODO maybe keep some of the precision errors of the original table?
-		double val = ( 0.5 + ( pow(2.0, -1.0 + ( 255 - s) * ( 1.0 /256 ) )) * ( 1 << MUL_SH ));
-		MulTable[i] = (Bit16u)(val);
+	previewPhase = phase;
+}
+
+void Handler::Generate( MixerChannel* chan, Bitu samples ) {
+	Bit32s buffer[ 512 * 2 ];
+	if ( GCC_UNLIKELY(samples > 512) )
+		samples = 512;
+	PROBE3( generate__entry, this, 1, samples );
+	Lanes* queue = Lanes::Get();
+	GenerateOutput( buffer, samples, 1, queue );
+	if ( queue )
+		queue->Flush();
+	if ( !chip.opl3Active ) {
+		chan->AddSamples_m32( samples, buffer );
+	} else {
+		chan->AddSamples_s32( samples, buffer );
 	}
+	PROBE3( generate__return, this, 1, samples );
+}
 
-	//Sine Wave Base
-	for ( int i = 0; i < 512; i++ ) {
-		WaveTable[ 0x0200 + i ] = (Bit16s)(sin( (i + 0.5) * (PI / 512.0) ) * 4084);
-		WaveTable[ 0x0000 + i ] = -WaveTable[ 0x200 + i ];
+void Handler::GenerateStems( MixerChannel* chans[ STEM_LANES ], Bitu samples ) {
+	if ( GCC_UNLIKELY(samples > 512) )
+		samples = 512;
+	if ( !stemBuffer ) {
+		stemBuffer = new Bit32s[ STEM_LANES * 512 * 2 ];
+	}
+	PROBE3( generate__entry, this, 1, samples );
+	Lanes* queue = Lanes::Get();
+	GenerateOutput( stemBuffer, samples, STEM_LANES, queue );
+	if ( queue )
+		queue->Flush();
+	if ( !chip.opl3Active ) {
+		for ( Bitu lane = 0; lane < STEM_LANES; lane++ ) {
+			chans[ lane ]->AddSamples_m32( samples, stemBuffer + lane * samples );
+		}
+	} else {
+		for ( Bitu lane = 0; lane < STEM_LANES; lane++ ) {
+			chans[ lane ]->AddSamples_s32( samples, stemBuffer + lane * samples * 2 );
+		}
 	}
-	//Exponential wave
-	for ( int i = 0; i < 256; i++ ) {
-		WaveTable[ 0x700 + i ] = (Bit16s)( 0.5 + ( pow(2.0, -1.0 + ( 255 - i * 8) * ( 1.0 /256 ) ) ) * 4085 );
-		WaveTable[ 0x6ff - i ] = -WaveTable[ 0x700 + i ];
+	PROBE3( generate__return, this, 1, samples );
+}
+
+void Handler::CopyState( const Handler& other ) {
+	chip = other.chip;
+	previewShift = other.previewShift;
+	memcpy( previewLast, other.previewLast, sizeof( previewLast ) );
+	memcpy( previewNext, other.previewNext, sizeof( previewNext ) );
+	previewPhase = other.previewPhase;
+}
+
+void Handler::MergeGroup( const Handler& other, Bit32u mask ) {
+	for ( Bitu i = 0; i < 18; i++ ) {
+		if ( mask & ( 1 << i ) )
+			chip.chan[ i ] = other.chip.chan[ i ];
 	}
-#endif
-#if ( DBOPL_WAVE == WAVE_TABLELOG )
-	//Sine Wave Base
-	for ( int i = 0; i < 512; i++ ) {
-		WaveTable[ 0x0200 + i ] = (Bit16s)( 0.5 - log10( sin( (i + 0.5) * (PI / 512.0) ) ) / log10(2.0)*256 );
-		WaveTable[ 0x0000 + i ] = ((Bit16s)0x8000) | WaveTable[ 0x200 + i];
-	}
-	//Exponential wave
-	for ( int i = 0; i < 256; i++ ) {
-		WaveTable[ 0x700 + i ] = i * 8;
-		WaveTable[ 0x6ff - i ] = ((Bit16s)0x8000) | i * 8;
-	} 
-#endif
+}
 
-	//	|    |//\\|____|WAV7|//__|/\  |____|/\/\|
-	//	|\\//|    |    |WAV7|    |  \/|    |    |
-	//	|06  |0126|27  |7   |3   |4   |4 5 |5   |
-
-#if (( DBOPL_WAVE == WAVE_TABLELOG ) || ( DBOPL_WAVE == WAVE_TABLEMUL ))
-	for ( int i = 0; i < 256; i++ ) {
-		//Fill silence gaps
-		WaveTable[ 0x400 + i ] = WaveTable[0];
-		WaveTable[ 0x500 + i ] = WaveTable[0];
-		WaveTable[ 0x900 + i ] = WaveTable[0];
-		WaveTable[ 0xc00 + i ] = WaveTable[0];
-		WaveTable[ 0xd00 + i ] = WaveTable[0];
-		//Replicate sines in other pieces
-		WaveTable[ 0x800 + i ] = WaveTable[ 0x200 + i ];
-		//double speed sines
-		WaveTable[ 0xa00 + i ] = WaveTable[ 0x200 + i * 2 ];
-		WaveTable[ 0xb00 + i ] = WaveTable[ 0x000 + i * 2 ];
-		WaveTable[ 0xe00 + i ] = WaveTable[ 0x200 + i * 2 ];
-		WaveTable[ 0xf00 + i ] = WaveTable[ 0x200 + i * 2 ];
-	} 
-#endif
+Bit32u Handler::GroupMask( Bitu group, Bitu count, bool fourOp ) {
+	//The percussion channels always stay together and are the busiest, so they come first
+	Bit32u mask = group == 0 ? 0x1c0 : 0;
+	//Then the other channels in turn, keeping the pairs together when 4-op mode can be turned on
+	Bitu unit = 1;
+	for ( Bitu ch = 0; ch < 18; unit++ ) {
+		if ( ch == 6 )
+			ch = 9;
+		Bitu width = ( fourOp && ch < 15 ) ? 2 : 1;
+		if ( unit % count == group )
+			mask |= ( ( 1 << width ) - 1 ) << ch;
+		ch += width;
+	}
+	return mask;
+}
+
+Handler::Handler() {
+	stemBuffer = 0;
+	previewShift = 0;
+	previewBuffer = 0;
+}
+
+Handler::~Handler() {
+	delete[] stemBuffer;
+	delete[] previewBuffer;
+}
+
+void Handler::Init( Bitu rate ) {
+	chip.Setup( rate >> previewShift );
+	chip.previewLimit = previewShift ? PREVIEW_LIMIT : 0;
+	memset( previewLast, 0, sizeof( previewLast ) );
+	memset( previewNext, 0, sizeof( previewNext ) );
+	previewPhase = (Bitu)1 << previewShift;
+}
+
+void Handler::SetPreview( Bitu shift ) {
+	previewShift = shift;
+}
+
+#ifdef LANES_AVX2
+//Volume multiplier of the lanes, silent operators multiply by 0
+static INLINE Bit32s LaneMul( Bitu vol ) {
+	return ENV_SILENT( vol ) ? 0 : MulTable[ vol >> ENV_EXTRA ];
+}
 
-	//Create the ksl table
-	for ( int oct = 0; oct < 8; oct++ ) {
-		int base = oct * 8;
-		for ( int i = 0; i < 16; i++ ) {
-			int val = base - KslCreateTable[i];
-			if ( val < 0 )
-				val = 0;
-			//*4 for the final range to match attenuation range
-			KslTable[ oct * 16 + i ] = val * 4;
+//BlockLoop for sm2FM and sm2AM across the first width lanes at once, Haswell tuning lets the compiler gather
+template<Bitu width>
+__attribute__(( target( "avx2,tune=haswell" ) )) static void LaneLoop( Lanes* l, Bitu samples ) {
+	//Copies of the state, so the compiler knows the output doesn't alias it
+	Bit32u index0[ width ], index1[ width ], add0[ width ], add1[ width ];
+	Bit32u base0[ width ], base1[ width ], mask0[ width ], mask1[ width ];
+	Bit32u shift[ width ];
+	Bit32s level0[ width ], level1[ width ];
+	Bit32s old0[ width ], old1[ width ], am[ width ], fm[ width ];
+	for ( Bitu i = 0; i < width; i++ ) {
+		index0[ i ] = l->index[ 0 ][ i ];
+		index1[ i ] = l->index[ 1 ][ i ];
+		add0[ i ] = l->add[ 0 ][ i ];
+		add1[ i ] = l->add[ 1 ][ i ];
+		base0[ i ] = l->base[ 0 ][ i ];
+		base1[ i ] = l->base[ 1 ][ i ];
+		mask0[ i ] = l->mask[ 0 ][ i ];
+		mask1[ i ] = l->mask[ 1 ][ i ];
+		level0[ i ] = l->level[ 0 ][ i ];
+		level1[ i ] = l->level[ 1 ][ i ];
+		shift[ i ] = l->shift[ i ];
+		old0[ i ] = l->old0[ i ];
+		old1[ i ] = l->old1[ i ];
+		am[ i ] = l->am[ i ];
+		fm[ i ] = l->fm[ i ];
+	}
+	for ( Bitu s = 0; s < samples; s++ ) {
+		const Bit32s* __restrict mul0 = l->mul[ 0 ][ s ];
+		const Bit32s* __restrict mul1 = l->mul[ 1 ][ s ];
+		Bit32s* __restrict out = l->out[ s ];
+		for ( Bitu i = 0; i < width; i++ ) {
+			Bit32s mod = (Bit32u)( old0[ i ] + old1[ i ] ) >> shift[ i ];
+			Bit32s out0 = old1[ i ];
+			old0[ i ] = out0;
+			index0[ i ] += add0[ i ];
+			//Signed offsets let the compiler gather with them
+			Bit32s wave0 = (Bit32s)( base0[ i ] + ( ( ( index0[ i ] >> WAVE_SH ) + mod ) & mask0[ i ] ) );
+			//Always loaded, so picking the volume doesn't need a branch
+			Bit32s dynamic0 = mul0[ i ];
+			Bit32s vol0 = level0[ i ] < 0 ? dynamic0 : level0[ i ];
+			old1[ i ] = ( LaneWaveTable[ wave0 ] * vol0 ) >> MUL_SH;
+			index1[ i ] += add1[ i ];
+			Bit32s wave1 = (Bit32s)( base1[ i ] + ( ( ( index1[ i ] >> WAVE_SH ) + ( out0 & fm[ i ] ) ) & mask1[ i ] ) );
+			Bit32s dynamic1 = mul1[ i ];
+			Bit32s vol1 = level1[ i ] < 0 ? dynamic1 : level1[ i ];
+			out[ i ] = ( out0 & am[ i ] ) + ( ( LaneWaveTable[ wave1 ] * vol1 ) >> MUL_SH );
 		}
 	}
-	//Create the Tremolo table, just increase and decrease a triangle wave
-	for ( Bit8u i = 0; i < TREMOLO_TABLE / 2; i++ ) {
-		Bit8u val = i << ENV_EXTRA;
-		TremoloTable[i] = val;
-		TremoloTable[TREMOLO_TABLE - 1 - i] = val;
-	}
-	//Create a table with offsets of the channels from the start of the chip
-	DBOPL::Chip* chip = 0;
-	for ( Bitu i = 0; i < 32; i++ ) {
-		Bitu index = i & 0xf;
-		if ( index >= 9 ) {
-			ChanOffsetTable[i] = 0;
-			continue;
-		}
-		//Make sure the four op channels follow eachother
-		if ( index < 6 ) {
-			index = (index % 3) * 2 + ( index / 3 );
+	for ( Bitu i = 0; i < width; i++ ) {
+		l->index[ 0 ][ i ] = index0[ i ];
+		l->index[ 1 ][ i ] = index1[ i ];
+		l->old0[ i ] = old0[ i ];
+		l->old1[ i ] = old1[ i ];
+	}
+}
+
+void Lanes::Add( Channel* ch, Bit32u samples, Bit32s* output, bool stereo, bool am, LoopHandler loop ) {
+	if ( count && samples != this->samples )
+		Flush();
+	this->samples = samples;
+	const Bitu i = count++;
+	channel[ i ] = ch;
+	this->output[ i ] = output;
+	this->stereo[ i ] = stereo;
+	this->loop[ i ] = loop;
+	for ( Bitu o = 0; o < 2; o++ ) {
+		Operator* op = ch->Op( o );
+		index[ o ][ i ] = op->waveIndex;
+		add[ o ][ i ] = op->waveCurrent;
+		base[ o ][ i ] = (Bit32u)( op->waveBase - WaveTable );
+		mask[ o ][ i ] = op->waveMask;
+		if ( op->EnvelopeStatic() ) {
+			volume[ o ][ i ] = op->ForwardVolume();
+			level[ o ][ i ] = LaneMul( volume[ o ][ i ] );
+		} else {
+			level[ o ][ i ] = -1;
 		}
-		//Add back the bits for highest ones
-		if ( i >= 16 )
-			index += 9;
-		Bitu blah = reinterpret_cast<Bitu>( &(chip->chan[ index ]) );
-		ChanOffsetTable[i] = blah;
-	}
-	//Same for operators
-	for ( Bitu i = 0; i < 64; i++ ) {
-		if ( i % 8 >= 6 || ( (i / 8) % 4 == 3 ) ) {
-			OpOffsetTable[i] = 0;
-			continue;
+	}
+	shift[ i ] = ch->feedback;
+	old0[ i ] = ch->old[0];
+	old1[ i ] = ch->old[1];
+	this->am[ i ] = am ? -1 : 0;
+	fm[ i ] = am ? 0 : -1;
+	if ( count == LANE_COUNT )
+		Flush();
+}
+
+void Lanes::Flush() {
+	if ( !count )
+		return;
+	//A vector of lanes takes as long as a few channels in their own specialized loops
+	if ( count < LANE_MINIMUM ) {
+		for ( Bitu i = 0; i < count; i++ ) {
+			const Bitu vol[ 2 ] = { volume[ 0 ][ i ], volume[ 1 ][ i ] };
+			( channel[ i ]->*loop[ i ] )( samples, output[ i ], vol );
 		}
-		Bitu chNum = (i / 8) * 3 + (i % 8) % 3;
-		//Make sure we use 16 and up for the 2nd range to match the chanoffset gap
-		if ( chNum >= 12 )
-			chNum += 16 - 12;
-		Bitu opNum = ( i % 8 ) / 3;
-		DBOPL::Channel* chan = 0;
-		Bitu blah = reinterpret_cast<Bitu>( &(chan->op[opNum]) );
-		OpOffsetTable[i] = ChanOffsetTable[ chNum ] + blah;
+		count = 0;
+		return;
 	}
-#if 0
-	//Stupid checks if table's are correct
-	for ( Bitu i = 0; i < 18; i++ ) {
-		Bit32u find = (Bit16u)( &(chip->chan[ i ]) );
-		for ( Bitu c = 0; c < 32; c++ ) {
-			if ( ChanOffsetTable[c] == find ) {
-				find = 0;
-				break;
+	for ( Bitu done = 0; done < samples; ) {
+		Bitu todo = samples - done;
+		if ( todo > LANE_BLOCK )
+			todo = LANE_BLOCK;
+		//Envelopes that change are run ahead, they don't depend on the wave
+		for ( Bitu i = 0; i < count; i++ ) {
+			for ( Bitu o = 0; o < 2; o++ ) {
+				if ( level[ o ][ i ] >= 0 )
+					continue;
+				Operator* op = channel[ i ]->Op( o );
+				for ( Bitu s = 0; s < todo; s++ )
+					mul[ o ][ s ][ i ] = LaneMul( op->ForwardVolume() );
 			}
 		}
-		if ( find ) {
-			find = find;
+		//Lanes past the count run on whatever they last held, their results are thrown away
+		if ( count <= 8 ) {
+			LaneLoop< 8 >( this, todo );
+		} else if ( count <= 16 ) {
+			LaneLoop< 16 >( this, todo );
+		} else {
+			LaneLoop< LANE_COUNT >( this, todo );
 		}
-	}
-	for ( Bitu i = 0; i < 36; i++ ) {
-		Bit32u find = (Bit16u)( &(chip->chan[ i / 2 ].op[i % 2]) );
-		for ( Bitu c = 0; c < 64; c++ ) {
-			if ( OpOffsetTable[c] == find ) {
-				find = 0;
-				break;
+		for ( Bitu i = 0; i < count; i++ ) {
+			if ( !stereo[ i ] ) {
+				Bit32s* dest = output[ i ] + done;
+				for ( Bitu s = 0; s < todo; s++ )
+					dest[ s ] += out[ s ][ i ];
+			} else {
+				Bit32s* dest = output[ i ] + done * 2;
+				const Bit32s left = channel[ i ]->maskLeft;
+				const Bit32s right = channel[ i ]->maskRight;
+				for ( Bitu s = 0; s < todo; s++ ) {
+					dest[ s * 2 + 0 ] += out[ s ][ i ] & left;
+					dest[ s * 2 + 1 ] += out[ s ][ i ] & right;
+				}
 			}
 		}
-		if ( find ) {
-			find = find;
-		}
+		done += todo;
 	}
-#endif
+	for ( Bitu i = 0; i < count; i++ ) {
+		Channel* ch = channel[ i ];
+		ch->old[0] = old0[ i ];
+		ch->old[1] = old1[ i ];
+		ch->Op( 0 )->waveIndex = index[ 0 ][ i ];
+		ch->Op( 1 )->waveIndex = index[ 1 ][ i ];
+	}
+	count = 0;
 }
 
-Bit32u Handler::WriteAddr( Bit32u port, Bit8u val ) {
-	return chip.WriteAddr( port, val );
+Lanes* Lanes::Get() {
+	static const bool avx2 = __builtin_cpu_supports( "avx2" );
+	if ( !avx2 )
+		return 0;
+	//Only used during a call, so each thread needs just the one
+	static thread_local Lanes lanes;
+	return &lanes;
+}
+#else
+void Lanes::Add( Channel* ch, Bit32u samples, Bit32s* output, bool stereo, bool am, LoopHandler loop ) {
+}
 
+void Lanes::Flush() {
 }
-void Handler::WriteReg( Bit32u addr, Bit8u val ) {
-	chip.WriteReg( addr, val );
+
+Lanes* Lanes::Get() {
+	return 0;
 }
+#endif
 
-void Handler::Generate( MixerChannel* chan, Bitu samples ) {
-	Bit32s buffer[ 512 * 2 ];
-	if ( GCC_UNLIKELY(samples > 512) )
-		samples = 512;
-	if ( !chip.opl3Active ) {
-		chip.GenerateBlock2( samples, buffer );
-		chan->AddSamples_m32( samples, buffer );
-	} else {
-		chip.GenerateBlock3( samples, buffer );
-		chan->AddSamples_s32( samples, buffer );
+void Lanes::Generate( Handler* handlers, Bitu count, Bitu samples, Bit32s* output ) {
+	PROBE3( generate__entry, handlers, count, samples );
+	Lanes* queue = Get();
+	for ( Bitu i = 0; i < count; i++ ) {
+		handlers[ i ].GenerateOutput( output + i * 512 * 2, samples, 1, queue );
 	}
+	if ( queue )
+		queue->Flush();
+	PROBE3( generate__return, handlers, count, samples );
 }
 
-void Handler::Init( Bitu rate ) {
-	InitTables();
-	chip.Setup( rate );
+Lanes::Lanes() {
+	memset( this, 0, sizeof( *this ) );
 }
 
 
@@ -34,6 +34,7 @@ namespace DBOPL {
 struct Chip;
 struct Operator;
 struct Channel;
+struct Lanes;
 
 #if (DBOPL_WAVE == WAVE_HANDLER)
 typedef Bits ( DB_FASTCALL *WaveHandler) ( Bitu i, Bitu volume );
@@ -41,6 +42,7 @@ typedef Bits ( DB_FASTCALL *WaveHandler) ( Bitu i, Bitu volume );
 
 typedef Bits ( DBOPL::Operator::*VolumeHandler) ( );
 typedef Channel* ( DBOPL::Channel::*SynthHandler) ( Chip* chip, Bit32u samples, Bit32s* output );
+typedef void ( DBOPL::Channel::*LoopHandler) ( Bit32u samples, Bit32s* output, const Bitu* vol );
 
 //Different synth modes that can generate blocks of data
 typedef enum {
@@ -58,12 +60,37 @@ typedef enum {
 	sm3Percussion,
 } SynthMode;
 
+//Common channel settings the block generators are specialized for
+enum {
+	//Feedback is off, the modulation is just the sign of the last two samples
+	BLOCK_NOFEEDBACK = 0x1,
+	//OPL3 channel going to both outputs, so there's no masking
+	BLOCK_CENTRE = 0x2,
+	//None of the envelopes can change during the block, picked for each block
+	BLOCK_STATIC = 0x4,
+};
+
 //Shifts for the values contained in chandata variable
 enum {
 	SHIFT_KSLBASE = 16,
 	SHIFT_KEYCODE = 24,
 };
 
+//Output lanes when every channel is generated separately
+enum {
+	//Bass drum, hi-hat, snare, tom-tom and top cymbal follow the 18 channels
+	STEM_PERCUSSION = 18,
+	STEM_LANES = STEM_PERCUSSION + 5,
+};
+
+//Lane generator sizes
+enum {
+	//Most 2 operator channels run in lockstep
+	LANE_COUNT = 32,
+	//Samples generated at a time, small enough for the buffers to stay in the cache
+	LANE_BLOCK = 64,
+};
+
 struct Operator {
 public:
 	//Masks for operator 20 values
@@ -87,7 +114,7 @@ public:
 #if (DBOPL_WAVE == WAVE_HANDLER)
 	WaveHandler waveHandler;	//Routine that generate a wave 
 #else
-	Bit16s* waveBase;
+	const Bit16s* waveBase;
 	Bit32u waveMask;
 	Bit32u waveStart;
 #endif
@@ -137,6 +164,10 @@ public:
 	void WriteE0( const Chip* chip, Bit8u val );
 
 	bool Silent() const;
+	//Silent, or too quiet to matter in preview mode and unable to get louder on its own
+	bool Skippable( const Chip* chip ) const;
+	//Check if the envelope will stay at the current volume
+	bool EnvelopeStatic() const;
 	void Prepare( const Chip* chip );
 
 	void KeyOn( Bit8u mask);
@@ -150,7 +181,12 @@ public:
 	Bitu ForwardVolume();
 
 	Bits GetSample( Bits modulation );
+	//Same with the volume worked out before the block, for an envelope that can't change
+	Bits GetSample( Bits modulation, Bitu vol );
 	Bits GetWave( Bitu index, Bitu vol );
+	//Advance the envelope and wave like GetSample without generating anything
+	void Skip();
+	void Skip( Bitu samples );
 public:
 	Operator();
 };
@@ -171,6 +207,7 @@ struct Channel {
 	Bit8u fourMask;
 	Bit8s maskLeft;		//Sign extended values for both channel's panning
 	Bit8s maskRight;
+	bool freqDirty;		//Frequency changed, the operators get updated before the next block
 
 	//Forward the channel data to the operators of the channel
 	void SetChanData( const Chip* chip, Bit32u data );
@@ -181,16 +218,39 @@ struct Channel {
 	void WriteC0( const Chip* chip, Bit8u val );
 	void ResetC0( const Chip* chip );
 
-	//call this for the first channel
+	//call this for the first channel, generates a block of every percussion voice
 	template< bool opl3Mode >
-	void GeneratePercussion( Chip* chip, Bit32s* output );
+	void GeneratePercussion( Chip* chip, Bitu samples, Bit32s* output );
 
 	//Generate blocks of data in specific modes
-	template<SynthMode mode>
+	template<SynthMode mode, Bit8u flags>
 	Channel* BlockTemplate( Chip* chip, Bit32u samples, Bit32s* output );
+	//The sample loop of a block, vol holds the operator volumes with BLOCK_STATIC
+	template<SynthMode mode, Bit8u flags>
+	void BlockLoop( Bit32u samples, Bit32s* output, const Bitu* vol );
 	Channel();
 };
 
+//Tables that only depend on the sample rate, shared by all chips running at that rate
+struct RateTables {
+	//Frequency scales for the different multiplications
+	Bit32u freqMul[16];
+	//Rates for decay and release for rate of this chip
+	Bit32u linearRates[76];
+	//Best match attack rates for the rate of this chip
+	Bit32u attackRates[76];
+
+	void Setup( Bit32u rate );
+};
+
+//LFO values for the samples up to the next LFO step
+struct LFOSegment {
+	Bit32u samples;
+	Bit8u tremoloValue;
+	Bit8s vibratoSign;
+	Bit8u vibratoShift;
+};
+
 struct Chip {
 	//This is used as the base counter for vibrato and tremolo
 	Bit32u lfoCounter;
@@ -201,12 +261,8 @@ struct Chip {
 	Bit32u noiseAdd;
 	Bit32u noiseValue;
 
-	//Frequency scales for the different multiplications
-	Bit32u freqMul[16];
-	//Rates for decay and release for rate of this chip
-	Bit32u linearRates[76];
-	//Best match attack rates for the rate of this chip
-	Bit32u attackRates[76];
+	//Shared with every other chip at the same rate
+	const RateTables* rates;
 
 	//18 channels with 2 operators each
 	Channel chan[18];
@@ -227,12 +283,44 @@ struct Chip {
 	//0 or -1 when enabled
 	Bit8s opl3Active;
 
+	//Distance between the output lanes of each channel, 0 to mix all channels together
+	Bitu laneStride;
+	//Bit for each output lane, cleared to mute that channel or percussion voice
+	Bit32u channelMask;
+	//Bit for each channel this copy of the chip generates, the rest are skipped and left to another copy
+	Bit32u groupMask;
+
+	//Last value written to each register
+	Bit8u regShadow[ 512 ];
+	//Set once a 4-op channel has been enabled, channel writes can then be ignored by the chip
+	bool fourOpSeen;
+	//Set when a channel might have a frequency update pending
+	bool freqDirty;
+	//Attenuation at which preview mode skips a channel, 0 when not previewing
+	Bit32u previewLimit;
+	//Where 2 operator channels are queued while generating with other chips, 0 to generate them straight away
+	Lanes* lanes;
+
 	//Return the maximum amount of samples before and LFO change
 	Bit32u ForwardLFO( Bit32u samples );
-	Bit32u ForwardNoise();
-
+	//Forward the LFO over as much of the block as fits in the schedule, returns the number of segments
+	Bitu ScheduleLFO( Bitu total, LFOSegment* schedule, Bitu* samples );
+	//Generate a block for a channel, only stopping at the LFO steps when it uses tremolo or vibrato or an envelope is moving
+	bool ChannelSinglePass( const Channel* ch ) const;
+	Channel* GenerateChannel( Channel* ch, Bitu samples, const LFOSegment* schedule, Bitu segments, Bit32s* output, Bitu channels );
+	//Forward the noise generator, giving its lowest bit after each sample
+	void ForwardNoise( Bitu samples, Bit8u* bits );
+
+	//Where a channel writes its samples, its own lane when generating stems
+	Bit32s* ChannelOutput( Channel* ch, Bit32s* output );
+	bool ChannelEnabled( Channel* ch ) const;
+	void ClearOutput( Bit32s* output, Bitu size );
+
+	//Forward pending frequency changes to the operators
+	void UpdateChannels();
 	void WriteBD( Bit8u val );
 	void WriteReg(Bit32u reg, Bit8u val );
+	Bit8u ReadReg( Bit32u reg ) const;
 
 	Bit32u WriteAddr( Bit32u port, Bit8u val );
 
@@ -240,17 +328,83 @@ struct Chip {
 	void GenerateBlock3( Bitu samples, Bit32s* output );
 
 	void Generate( Bit32u samples );
+	//Copy in a freshly reset chip for this rate, creating it the first time
 	void Setup( Bit32u r );
+	//Reset every register the slow way
+	void Reset( Bit32u r, const RateTables* tables );
 
 	Chip();
 };
 
 struct Handler : public Adlib::Handler {
 	DBOPL::Chip chip;
+	//STEM_LANES buffers for GenerateStems, allocated on first use
+	Bit32s* stemBuffer;
+	//Preview mode runs the chip at the rate >> previewShift and interpolates its output back up
+	Bitu previewShift;
+	//Chip rate samples to interpolate from, allocated on first use
+	Bit32s* previewBuffer;
+	//Last two chip samples of every lane and side, and how far the output has got between them
+	Bit32s previewLast[ STEM_LANES * 2 ];
+	Bit32s previewNext[ STEM_LANES * 2 ];
+	Bitu previewPhase;
+	//Fill the output with the chip's lanes at the output rate, with a queue it's only complete after the queue's Flush
+	void GenerateOutput( Bit32s* output, Bitu samples, Bitu lanes, Lanes* queue );
 	virtual Bit32u WriteAddr( Bit32u port, Bit8u val );
 	virtual void WriteReg( Bit32u addr, Bit8u val );
 	virtual void Generate( MixerChannel* chan, Bitu samples );
+	//Generate each channel and percussion voice separately, one MixerChannel per lane
+	void GenerateStems( MixerChannel* chans[ STEM_LANES ], Bitu samples );
 	virtual void Init( Bitu rate );
+	//Trade accuracy for speed, 0 for exact emulation, applies from the next Init
+	void SetPreview( Bitu shift );
+	//Take over the emulated state of another handler
+	void CopyState( const Handler& other );
+	//Take over the channels in mask from a copy of this handler that generated them
+	void MergeGroup( const Handler& other, Bit32u mask );
+	//Channels of one of count groups that can be generated apart, 0 for groups beyond the last channel
+	static Bit32u GroupMask( Bitu group, Bitu count, bool fourOp );
+	Handler();
+	virtual ~Handler();
+};
+
+//2 operator channels from any number of chips, packed one per lane and generated in lockstep
+struct Lanes {
+	//Channels in the pack and the length of the block they're waiting for
+	Bitu count;
+	Bit32u samples;
+	Channel* channel[ LANE_COUNT ];
+	Bit32s* output[ LANE_COUNT ];
+	bool stereo[ LANE_COUNT ];
+	//The channel's own block loop and static volumes, for when there are too few channels to fill the lanes
+	LoopHandler loop[ LANE_COUNT ];
+	Bitu volume[ 2 ][ LANE_COUNT ];
+	//State of both operators, with the wave as an offset into the table
+	Bit32u index[ 2 ][ LANE_COUNT ];
+	Bit32u add[ 2 ][ LANE_COUNT ];
+	Bit32u base[ 2 ][ LANE_COUNT ];
+	Bit32u mask[ 2 ][ LANE_COUNT ];
+	//Volume multiplier of operators with a static envelope, -1 when it's in mul for each sample
+	Bit32s level[ 2 ][ LANE_COUNT ];
+	//Channel state, am and fm are -1 or 0 to pick the connection
+	Bit32u shift[ LANE_COUNT ];
+	Bit32s old0[ LANE_COUNT ];
+	Bit32s old1[ LANE_COUNT ];
+	Bit32s am[ LANE_COUNT ];
+	Bit32s fm[ LANE_COUNT ];
+	//Volume multipliers of the changing envelopes and the samples generated, for the current part of the block
+	Bit32s mul[ 2 ][ LANE_BLOCK ][ LANE_COUNT ];
+	Bit32s out[ LANE_BLOCK ][ LANE_COUNT ];
+
+	//Take over generating a channel's block, it's finished by the next Flush
+	void Add( Channel* ch, Bit32u samples, Bit32s* output, bool stereo, bool am, LoopHandler loop );
+	//Generate every queued channel
+	void Flush();
+	//Generate a block for each handler with their channels sharing the lanes, each handler's output 512 * 2 after the last's
+	static void Generate( Handler* handlers, Bitu count, Bitu samples, Bit32s* output );
+	//Queue of the calling thread, 0 when the cpu is better off without lanes
+	static Lanes* Get();
+	Lanes();
 };
 
 
@@ -0,0 +1,915 @@
+//Generated by gen_dbopl_tables.py, do not edit
+
+#if ( DBOPL_WAVE == WAVE_HANDLER ) || ( DBOPL_WAVE == WAVE_TABLELOG )
+static const Bit16u ExpTable[ 256 ] = {
+	4084, 4074, 4062, 4052, 4040, 4030, 4020, 4008, 3998, 3986, 3976, 3966, 3954, 3944, 3932, 3922,
+	3912, 3902, 3890, 3880, 3870, 3860, 3848, 3838, 3828, 3818, 3808, 3796, 3786, 3776, 3766, 3756,
+	3746, 3736, 3726, 3716, 3706, 3696, 3686, 3676, 3666, 3656, 3646, 3636, 3626, 3616, 3606, 3596,
+	3588, 3578, 3568, 3558, 3548, 3538, 3530, 3520, 3510, 3500, 3492, 3482, 3472, 3464, 3454, 3444,
+	3434, 3426, 3416, 3408, 3398, 3388, 3380, 3370, 3362, 3352, 3344, 3334, 3326, 3316, 3308, 3298,
+	3290, 3280, 3272, 3262, 3254, 3246, 3236, 3228, 3218, 3210, 3202, 3192, 3184, 3176, 3168, 3158,
+	3150, 3142, 3132, 3124, 3116, 3108, 3100, 3090, 3082, 3074, 3066, 3058, 3050, 3040, 3032, 3024,
+	3016, 3008, 3000, 2992, 2984, 2976, 2968, 2960, 2952, 2944, 2936, 2928, 2920, 2912, 2904, 2896,
+	2888, 2880, 2872, 2866, 2858, 2850, 2842, 2834, 2826, 2818, 2812, 2804, 2796, 2788, 2782, 2774,
+	2766, 2758, 2752, 2744, 2736, 2728, 2722, 2714, 2706, 2700, 2692, 2684, 2678, 2670, 2664, 2656,
+	2648, 2642, 2634, 2628, 2620, 2614, 2606, 2600, 2592, 2584, 2578, 2572, 2564, 2558, 2550, 2544,
+	2536, 2530, 2522, 2516, 2510, 2502, 2496, 2488, 2482, 2476, 2468, 2462, 2456, 2448, 2442, 2436,
+	2428, 2422, 2416, 2410, 2402, 2396, 2390, 2384, 2376, 2370, 2364, 2358, 2352, 2344, 2338, 2332,
+	2326, 2320, 2314, 2308, 2300, 2294, 2288, 2282, 2276, 2270, 2264, 2258, 2252, 2246, 2240, 2234,
+	2228, 2222, 2216, 2210, 2204, 2198, 2192, 2186, 2180, 2174, 2168, 2162, 2156, 2150, 2144, 2138,
+	2132, 2128, 2122, 2116, 2110, 2104, 2098, 2092, 2088, 2082, 2076, 2070, 2064, 2060, 2054, 2048,
+};
+#endif
+
+#if ( DBOPL_WAVE == WAVE_HANDLER )
+//PI table used by WAVEHANDLER
+static const Bit16u SinTable[ 512 ] = {
+	2137, 1731, 1543, 1419, 1326, 1252, 1190, 1137, 1091, 1050, 1013, 979, 949, 920, 894, 869,
+	846, 825, 804, 785, 767, 749, 732, 717, 701, 687, 672, 659, 646, 633, 621, 609,
+	598, 587, 576, 566, 556, 546, 536, 527, 518, 509, 501, 492, 484, 476, 468, 461,
+	453, 446, 439, 432, 425, 418, 411, 405, 399, 392, 386, 380, 375, 369, 363, 358,
+	352, 347, 341, 336, 331, 326, 321, 316, 311, 307, 302, 297, 293, 289, 284, 280,
+	276, 271, 267, 263, 259, 255, 251, 248, 244, 240, 236, 233, 229, 226, 222, 219,
+	215, 212, 209, 205, 202, 199, 196, 193, 190, 187, 184, 181, 178, 175, 172, 169,
+	167, 164, 161, 159, 156, 153, 151, 148, 146, 143, 141, 138, 136, 134, 131, 129,
+	127, 125, 122, 120, 118, 116, 114, 112, 110, 108, 106, 104, 102, 100, 98, 96,
+	94, 92, 91, 89, 87, 85, 83, 82, 80, 78, 77, 75, 74, 72, 70, 69,
+	67, 66, 64, 63, 62, 60, 59, 57, 56, 55, 53, 52, 51, 49, 48, 47,
+	46, 45, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30,
+	29, 28, 27, 26, 25, 24, 23, 23, 22, 21, 20, 20, 19, 18, 17, 17,
+	16, 15, 15, 14, 13, 13, 12, 12, 11, 10, 10, 9, 9, 8, 8, 7,
+	7, 7, 6, 6, 5, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2,
+	2, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2,
+	2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 6, 6, 7, 7,
+	7, 8, 8, 9, 9, 10, 10, 11, 12, 12, 13, 13, 14, 15, 15, 16,
+	17, 17, 18, 19, 20, 20, 21, 22, 23, 23, 24, 25, 26, 27, 28, 29,
+	30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 45, 46,
+	47, 48, 49, 51, 52, 53, 55, 56, 57, 59, 60, 62, 63, 64, 66, 67,
+	69, 70, 72, 74, 75, 77, 78, 80, 82, 83, 85, 87, 89, 91, 92, 94,
+	96, 98, 100, 102, 104, 106, 108, 110, 112, 114, 116, 118, 120, 122, 125, 127,
+	129, 131, 134, 136, 138, 141, 143, 146, 148, 151, 153, 156, 159, 161, 164, 167,
+	169, 172, 175, 178, 181, 184, 187, 190, 193, 196, 199, 202, 205, 209, 212, 215,
+	219, 222, 226, 229, 233, 236, 240, 244, 248, 251, 255, 259, 263, 267, 271, 276,
+	280, 284, 289, 293, 297, 302, 307, 311, 316, 321, 326, 331, 336, 341, 347, 352,
+	358, 363, 369, 375, 380, 386, 392, 399, 405, 411, 418, 425, 432, 439, 446, 453,
+	461, 468, 476, 484, 492, 501, 509, 518, 527, 536, 546, 556, 566, 576, 587, 598,
+	609, 621, 633, 646, 659, 672, 687, 701, 717, 732, 749, 767, 785, 804, 825, 846,
+	869, 894, 920, 949, 979, 1013, 1050, 1091, 1137, 1190, 1252, 1326, 1419, 1543, 1731, 2137,
+};
+#endif
+
+#if ( DBOPL_WAVE == WAVE_TABLEMUL )
+static const Bit16s WaveTable[ 8 * 512 ] = {
+	-12, -37, -62, -87, -112, -137, -162, -187, -212, -237, -262, -287, -312, -337, -362, -387,
+	-412, -437, -462, -487, -512, -537, -562, -586, -611, -636, -661, -685, -710, -735, -759, -784,
+	-809, -833, -858, -882, -907, -931, -955, -980, -1004, -1028, -1052, -1077, -1101, -1125, -1149, -1173,
+	-1197, -1221, -1245, -1269, -1292, -1316, -1340, -1364, -1387, -1411, -1434, -1458, -1481, -1504, -1528, -1551,
+	-1574, -1597, -1620, -1643, -1666, -1689, -1712, -1734, -1757, -1780, -1802, -1825, -1847, -1869, -1891, -1914,
+	-1936, -1958, -1980, -2002, -2023, -2045, -2067, -2088, -2110, -2131, -2153, -2174, -2195, -2216, -2237, -2258,
+	-2279, -2300, -2320, -2341, -2361, -2382, -2402, -2422, -2442, -2462, -2482, -2502, -2522, -2542, -2561, -2581,
+	-2600, -2619, -2638, -2658, -2677, -2695, -2714, -2733, -2751, -2770, -2788, -2806, -2825, -2843, -2861, -2878,
+	-2896, -2914, -2931, -2949, -2966, -2983, -3000, -3017, -3034, -3051, -3067, -3084, -3100, -3116, -3132, -3149,
+	-3164, -3180, -3196, -3211, -3227, -3242, -3257, -3272, -3287, -3302, -3317, -3331, -3346, -3360, -3374, -3388,
+	-3402, -3416, -3430, -3443, -3457, -3470, -3483, -3496, -3509, -3522, -3534, -3547, -3559, -3571, -3583, -3595,
+	-3607, -3619, -3630, -3642, -3653, -3664, -3675, -3686, -3697, -3707, -3718, -3728, -3738, -3748, -3758, -3768,
+	-3777, -3787, -3796, -3805, -3814, -3823, -3832, -3841, -3849, -3857, -3865, -3873, -3881, -3889, -3897, -3904,
+	-3911, -3918, -3925, -3932, -3939, -3945, -3952, -3958, -3964, -3970, -3976, -3982, -3987, -3992, -3998, -4003,
+	-4007, -4012, -4017, -4021, -4025, -4030, -4034, -4037, -4041, -4045, -4048, -4051, -4054, -4057, -4060, -4063,
+	-4065, -4067, -4069, -4071, -4073, -4075, -4077, -4078, -4079, -4080, -4081, -4082, -4083, -4083, -4083, -4083,
+	-4083, -4083, -4083, -4083, -4082, -4081, -4080, -4079, -4078, -4077, -4075, -4073, -4071, -4069, -4067, -4065,
+	-4063, -4060, -4057, -4054, -4051, -4048, -4045, -4041, -4037, -4034, -4030, -4025, -4021, -4017, -4012, -4007,
+	-4003, -3998, -3992, -3987, -3982, -3976, -3970, -3964, -3958, -3952, -3945, -3939, -3932, -3925, -3918, -3911,
+	-3904, -3897, -3889, -3881, -3873, -3865, -3857, -3849, -3841, -3832, -3823, -3814, -3805, -3796, -3787, -3777,
+	-3768, -3758, -3748, -3738, -3728, -3718, -3707, -3697, -3686, -3675, -3664, -3653, -3642, -3630, -3619, -3607,
+	-3595, -3583, -3571, -3559, -3547, -3534, -3522, -3509, -3496, -3483, -3470, -3457, -3443, -3430, -3416, -3402,
+	-3388, -3374, -3360, -3346, -3331, -3317, -3302, -3287, -3272, -3257, -3242, -3227, -3211, -3196, -3180, -3164,
+	-3149, -3132, -3116, -3100, -3084, -3067, -3051, -3034, -3017, -3000, -2983, -2966, -2949, -2931, -2914, -2896,
+	-2878, -2861, -2843, -2825, -2806, -2788, -2770, -2751, -2733, -2714, -2695, -2677, -2658, -2638, -2619, -2600,
+	-2581, -2561, -2542, -2522, -2502, -2482, -2462, -2442, -2422, -2402, -2382, -2361, -2341, -2320, -2300, -2279,
+	-2258, -2237, -2216, -2195, -2174, -2153, -2131, -2110, -2088, -2067, -2045, -2023, -2002, -1980, -1958, -1936,
+	-1914, -1891, -1869, -1847, -1825, -1802, -1780, -1757, -1734, -1712, -1689, -1666, -1643, -1620, -1597, -1574,
+	-1551, -1528, -1504, -1481, -1458, -1434, -1411, -1387, -1364, -1340, -1316, -1292, -1269, -1245, -1221, -1197,
+	-1173, -1149, -1125, -1101, -1077, -1052, -1028, -1004, -980, -955, -931, -907, -882, -858, -833, -809,
+	-784, -759, -735, -710, -685, -661, -636, -611, -586, -562, -537, -512, -487, -462, -437, -412,
+	-387, -362, -337, -312, -287, -262, -237, -212, -187, -162, -137, -112, -87, -62, -37, -12,
+	12, 37, 62, 87, 112, 137, 162, 187, 212, 237, 262, 287, 312, 337, 362, 387,
+	412, 437, 462, 487, 512, 537, 562, 586, 611, 636, 661, 685, 710, 735, 759, 784,
+	809, 833, 858, 882, 907, 931, 955, 980, 1004, 1028, 1052, 1077, 1101, 1125, 1149, 1173,
+	1197, 1221, 1245, 1269, 1292, 1316, 1340, 1364, 1387, 1411, 1434, 1458, 1481, 1504, 1528, 1551,
+	1574, 1597, 1620, 1643, 1666, 1689, 1712, 1734, 1757, 1780, 1802, 1825, 1847, 1869, 1891, 1914,
+	1936, 1958, 1980, 2002, 2023, 2045, 2067, 2088, 2110, 2131, 2153, 2174, 2195, 2216, 2237, 2258,
+	2279, 2300, 2320, 2341, 2361, 2382, 2402, 2422, 2442, 2462, 2482, 2502, 2522, 2542, 2561, 2581,
+	2600, 2619, 2638, 2658, 2677, 2695, 2714, 2733, 2751, 2770, 2788, 2806, 2825, 2843, 2861, 2878,
+	2896, 2914, 2931, 2949, 2966, 2983, 3000, 3017, 3034, 3051, 3067, 3084, 3100, 3116, 3132, 3149,
+	3164, 3180, 3196, 3211, 3227, 3242, 3257, 3272, 3287, 3302, 3317, 3331, 3346, 3360, 3374, 3388,
+	3402, 3416, 3430, 3443, 3457, 3470, 3483, 3496, 3509, 3522, 3534, 3547, 3559, 3571, 3583, 3595,
+	3607, 3619, 3630, 3642, 3653, 3664, 3675, 3686, 3697, 3707, 3718, 3728, 3738, 3748, 3758, 3768,
+	3777, 3787, 3796, 3805, 3814, 3823, 3832, 3841, 3849, 3857, 3865, 3873, 3881, 3889, 3897, 3904,
+	3911, 3918, 3925, 3932, 3939, 3945, 3952, 3958, 3964, 3970, 3976, 3982, 3987, 3992, 3998, 4003,
+	4007, 4012, 4017, 4021, 4025, 4030, 4034, 4037, 4041, 4045, 4048, 4051, 4054, 4057, 4060, 4063,
+	4065, 4067, 4069, 4071, 4073, 4075, 4077, 4078, 4079, 4080, 4081, 4082, 4083, 4083, 4083, 4083,
+	4083, 4083, 4083, 4083, 4082, 4081, 4080, 4079, 4078, 4077, 4075, 4073, 4071, 4069, 4067, 4065,
+	4063, 4060, 4057, 4054, 4051, 4048, 4045, 4041, 4037, 4034, 4030, 4025, 4021, 4017, 4012, 4007,
+	4003, 3998, 3992, 3987, 3982, 3976, 3970, 3964, 3958, 3952, 3945, 3939, 3932, 3925, 3918, 3911,
+	3904, 3897, 3889, 3881, 3873, 3865, 3857, 3849, 3841, 3832, 3823, 3814, 3805, 3796, 3787, 3777,
+	3768, 3758, 3748, 3738, 3728, 3718, 3707, 3697, 3686, 3675, 3664, 3653, 3642, 3630, 3619, 3607,
+	3595, 3583, 3571, 3559, 3547, 3534, 3522, 3509, 3496, 3483, 3470, 3457, 3443, 3430, 3416, 3402,
+	3388, 3374, 3360, 3346, 3331, 3317, 3302, 3287, 3272, 3257, 3242, 3227, 3211, 3196, 3180, 3164,
+	3149, 3132, 3116, 3100, 3084, 3067, 3051, 3034, 3017, 3000, 2983, 2966, 2949, 2931, 2914, 2896,
+	2878, 2861, 2843, 2825, 2806, 2788, 2770, 2751, 2733, 2714, 2695, 2677, 2658, 2638, 2619, 2600,
+	2581, 2561, 2542, 2522, 2502, 2482, 2462, 2442, 2422, 2402, 2382, 2361, 2341, 2320, 2300, 2279,
+	2258, 2237, 2216, 2195, 2174, 2153, 2131, 2110, 2088, 2067, 2045, 2023, 2002, 1980, 1958, 1936,
+	1914, 1891, 1869, 1847, 1825, 1802, 1780, 1757, 1734, 1712, 1689, 1666, 1643, 1620, 1597, 1574,
+	1551, 1528, 1504, 1481, 1458, 1434, 1411, 1387, 1364, 1340, 1316, 1292, 1269, 1245, 1221, 1197,
+	1173, 1149, 1125, 1101, 1077, 1052, 1028, 1004, 980, 955, 931, 907, 882, 858, 833, 809,
+	784, 759, 735, 710, 685, 661, 636, 611, 586, 562, 537, 512, 487, 462, 437, 412,
+	387, 362, 337, 312, 287, 262, 237, 212, 187, 162, 137, 112, 87, 62, 37, 12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-16, -17, -17, -17, -18, -18, -19, -19, -19, -20, -20, -21, -21, -22, -22, -23,
+	-23, -24, -24, -25, -25, -26, -26, -27, -27, -28, -29, -29, -30, -30, -31, -32,
+	-33, -33, -34, -35, -35, -36, -37, -38, -39, -40, -40, -41, -42, -43, -44, -45,
+	-46, -47, -48, -49, -50, -51, -52, -54, -55, -56, -57, -58, -60, -61, -62, -64,
+	-65, -66, -68, -69, -71, -72, -74, -76, -77, -79, -81, -83, -84, -86, -88, -90,
+	-92, -94, -96, -98, -100, -103, -105, -107, -109, -112, -114, -117, -119, -122, -125, -127,
+	-130, -133, -136, -139, -142, -145, -148, -151, -155, -158, -162, -165, -169, -172, -176, -180,
+	-184, -188, -192, -196, -201, -205, -210, -214, -219, -224, -228, -233, -239, -244, -249, -255,
+	-260, -266, -272, -278, -284, -290, -296, -303, -309, -316, -323, -330, -337, -345, -352, -360,
+	-368, -376, -384, -393, -401, -410, -419, -428, -438, -447, -457, -467, -477, -488, -498, -509,
+	-520, -532, -543, -555, -567, -580, -593, -606, -619, -632, -646, -660, -675, -690, -705, -720,
+	-736, -752, -769, -785, -803, -820, -838, -856, -875, -894, -914, -934, -954, -975, -997, -1018,
+	-1041, -1064, -1087, -1111, -1135, -1160, -1185, -1211, -1238, -1265, -1293, -1321, -1350, -1379, -1409, -1440,
+	-1472, -1504, -1537, -1571, -1605, -1640, -1676, -1713, -1750, -1789, -1828, -1868, -1909, -1951, -1993, -2037,
+	-2082, -2127, -2174, -2221, -2270, -2320, -2370, -2422, -2475, -2530, -2585, -2642, -2699, -2759, -2819, -2881,
+	-2944, -3008, -3074, -3141, -3210, -3281, -3352, -3426, -3501, -3577, -3656, -3736, -3818, -3901, -3987, -4074,
+	4074, 3987, 3901, 3818, 3736, 3656, 3577, 3501, 3426, 3352, 3281, 3210, 3141, 3074, 3008, 2944,
+	2881, 2819, 2759, 2699, 2642, 2585, 2530, 2475, 2422, 2370, 2320, 2270, 2221, 2174, 2127, 2082,
+	2037, 1993, 1951, 1909, 1868, 1828, 1789, 1750, 1713, 1676, 1640, 1605, 1571, 1537, 1504, 1472,
+	1440, 1409, 1379, 1350, 1321, 1293, 1265, 1238, 1211, 1185, 1160, 1135, 1111, 1087, 1064, 1041,
+	1018, 997, 975, 954, 934, 914, 894, 875, 856, 838, 820, 803, 785, 769, 752, 736,
+	720, 705, 690, 675, 660, 646, 632, 619, 606, 593, 580, 567, 555, 543, 532, 520,
+	509, 498, 488, 477, 467, 457, 447, 438, 428, 419, 410, 401, 393, 384, 376, 368,
+	360, 352, 345, 337, 330, 323, 316, 309, 303, 296, 290, 284, 278, 272, 266, 260,
+	255, 249, 244, 239, 233, 228, 224, 219, 214, 210, 205, 201, 196, 192, 188, 184,
+	180, 176, 172, 169, 165, 162, 158, 155, 151, 148, 145, 142, 139, 136, 133, 130,
+	127, 125, 122, 119, 117, 114, 112, 109, 107, 105, 103, 100, 98, 96, 94, 92,
+	90, 88, 86, 84, 83, 81, 79, 77, 76, 74, 72, 71, 69, 68, 66, 65,
+	64, 62, 61, 60, 58, 57, 56, 55, 54, 52, 51, 50, 49, 48, 47, 46,
+	45, 44, 43, 42, 41, 40, 40, 39, 38, 37, 36, 35, 35, 34, 33, 33,
+	32, 31, 30, 30, 29, 29, 28, 27, 27, 26, 26, 25, 25, 24, 24, 23,
+	23, 22, 22, 21, 21, 20, 20, 19, 19, 19, 18, 18, 17, 17, 17, 16,
+	12, 37, 62, 87, 112, 137, 162, 187, 212, 237, 262, 287, 312, 337, 362, 387,
+	412, 437, 462, 487, 512, 537, 562, 586, 611, 636, 661, 685, 710, 735, 759, 784,
+	809, 833, 858, 882, 907, 931, 955, 980, 1004, 1028, 1052, 1077, 1101, 1125, 1149, 1173,
+	1197, 1221, 1245, 1269, 1292, 1316, 1340, 1364, 1387, 1411, 1434, 1458, 1481, 1504, 1528, 1551,
+	1574, 1597, 1620, 1643, 1666, 1689, 1712, 1734, 1757, 1780, 1802, 1825, 1847, 1869, 1891, 1914,
+	1936, 1958, 1980, 2002, 2023, 2045, 2067, 2088, 2110, 2131, 2153, 2174, 2195, 2216, 2237, 2258,
+	2279, 2300, 2320, 2341, 2361, 2382, 2402, 2422, 2442, 2462, 2482, 2502, 2522, 2542, 2561, 2581,
+	2600, 2619, 2638, 2658, 2677, 2695, 2714, 2733, 2751, 2770, 2788, 2806, 2825, 2843, 2861, 2878,
+	2896, 2914, 2931, 2949, 2966, 2983, 3000, 3017, 3034, 3051, 3067, 3084, 3100, 3116, 3132, 3149,
+	3164, 3180, 3196, 3211, 3227, 3242, 3257, 3272, 3287, 3302, 3317, 3331, 3346, 3360, 3374, 3388,
+	3402, 3416, 3430, 3443, 3457, 3470, 3483, 3496, 3509, 3522, 3534, 3547, 3559, 3571, 3583, 3595,
+	3607, 3619, 3630, 3642, 3653, 3664, 3675, 3686, 3697, 3707, 3718, 3728, 3738, 3748, 3758, 3768,
+	3777, 3787, 3796, 3805, 3814, 3823, 3832, 3841, 3849, 3857, 3865, 3873, 3881, 3889, 3897, 3904,
+	3911, 3918, 3925, 3932, 3939, 3945, 3952, 3958, 3964, 3970, 3976, 3982, 3987, 3992, 3998, 4003,
+	4007, 4012, 4017, 4021, 4025, 4030, 4034, 4037, 4041, 4045, 4048, 4051, 4054, 4057, 4060, 4063,
+	4065, 4067, 4069, 4071, 4073, 4075, 4077, 4078, 4079, 4080, 4081, 4082, 4083, 4083, 4083, 4083,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	12, 62, 112, 162, 212, 262, 312, 362, 412, 462, 512, 562, 611, 661, 710, 759,
+	809, 858, 907, 955, 1004, 1052, 1101, 1149, 1197, 1245, 1292, 1340, 1387, 1434, 1481, 1528,
+	1574, 1620, 1666, 1712, 1757, 1802, 1847, 1891, 1936, 1980, 2023, 2067, 2110, 2153, 2195, 2237,
+	2279, 2320, 2361, 2402, 2442, 2482, 2522, 2561, 2600, 2638, 2677, 2714, 2751, 2788, 2825, 2861,
+	2896, 2931, 2966, 3000, 3034, 3067, 3100, 3132, 3164, 3196, 3227, 3257, 3287, 3317, 3346, 3374,
+	3402, 3430, 3457, 3483, 3509, 3534, 3559, 3583, 3607, 3630, 3653, 3675, 3697, 3718, 3738, 3758,
+	3777, 3796, 3814, 3832, 3849, 3865, 3881, 3897, 3911, 3925, 3939, 3952, 3964, 3976, 3987, 3998,
+	4007, 4017, 4025, 4034, 4041, 4048, 4054, 4060, 4065, 4069, 4073, 4077, 4079, 4081, 4083, 4083,
+	4083, 4083, 4082, 4080, 4078, 4075, 4071, 4067, 4063, 4057, 4051, 4045, 4037, 4030, 4021, 4012,
+	4003, 3992, 3982, 3970, 3958, 3945, 3932, 3918, 3904, 3889, 3873, 3857, 3841, 3823, 3805, 3787,
+	3768, 3748, 3728, 3707, 3686, 3664, 3642, 3619, 3595, 3571, 3547, 3522, 3496, 3470, 3443, 3416,
+	3388, 3360, 3331, 3302, 3272, 3242, 3211, 3180, 3149, 3116, 3084, 3051, 3017, 2983, 2949, 2914,
+	2878, 2843, 2806, 2770, 2733, 2695, 2658, 2619, 2581, 2542, 2502, 2462, 2422, 2382, 2341, 2300,
+	2258, 2216, 2174, 2131, 2088, 2045, 2002, 1958, 1914, 1869, 1825, 1780, 1734, 1689, 1643, 1597,
+	1551, 1504, 1458, 1411, 1364, 1316, 1269, 1221, 1173, 1125, 1077, 1028, 980, 931, 882, 833,
+	784, 735, 685, 636, 586, 537, 487, 437, 387, 337, 287, 237, 187, 137, 87, 37,
+	-12, -62, -112, -162, -212, -262, -312, -362, -412, -462, -512, -562, -611, -661, -710, -759,
+	-809, -858, -907, -955, -1004, -1052, -1101, -1149, -1197, -1245, -1292, -1340, -1387, -1434, -1481, -1528,
+	-1574, -1620, -1666, -1712, -1757, -1802, -1847, -1891, -1936, -1980, -2023, -2067, -2110, -2153, -2195, -2237,
+	-2279, -2320, -2361, -2402, -2442, -2482, -2522, -2561, -2600, -2638, -2677, -2714, -2751, -2788, -2825, -2861,
+	-2896, -2931, -2966, -3000, -3034, -3067, -3100, -3132, -3164, -3196, -3227, -3257, -3287, -3317, -3346, -3374,
+	-3402, -3430, -3457, -3483, -3509, -3534, -3559, -3583, -3607, -3630, -3653, -3675, -3697, -3718, -3738, -3758,
+	-3777, -3796, -3814, -3832, -3849, -3865, -3881, -3897, -3911, -3925, -3939, -3952, -3964, -3976, -3987, -3998,
+	-4007, -4017, -4025, -4034, -4041, -4048, -4054, -4060, -4065, -4069, -4073, -4077, -4079, -4081, -4083, -4083,
+	-4083, -4083, -4082, -4080, -4078, -4075, -4071, -4067, -4063, -4057, -4051, -4045, -4037, -4030, -4021, -4012,
+	-4003, -3992, -3982, -3970, -3958, -3945, -3932, -3918, -3904, -3889, -3873, -3857, -3841, -3823, -3805, -3787,
+	-3768, -3748, -3728, -3707, -3686, -3664, -3642, -3619, -3595, -3571, -3547, -3522, -3496, -3470, -3443, -3416,
+	-3388, -3360, -3331, -3302, -3272, -3242, -3211, -3180, -3149, -3116, -3084, -3051, -3017, -2983, -2949, -2914,
+	-2878, -2843, -2806, -2770, -2733, -2695, -2658, -2619, -2581, -2542, -2502, -2462, -2422, -2382, -2341, -2300,
+	-2258, -2216, -2174, -2131, -2088, -2045, -2002, -1958, -1914, -1869, -1825, -1780, -1734, -1689, -1643, -1597,
+	-1551, -1504, -1458, -1411, -1364, -1316, -1269, -1221, -1173, -1125, -1077, -1028, -980, -931, -882, -833,
+	-784, -735, -685, -636, -586, -537, -487, -437, -387, -337, -287, -237, -187, -137, -87, -37,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	12, 62, 112, 162, 212, 262, 312, 362, 412, 462, 512, 562, 611, 661, 710, 759,
+	809, 858, 907, 955, 1004, 1052, 1101, 1149, 1197, 1245, 1292, 1340, 1387, 1434, 1481, 1528,
+	1574, 1620, 1666, 1712, 1757, 1802, 1847, 1891, 1936, 1980, 2023, 2067, 2110, 2153, 2195, 2237,
+	2279, 2320, 2361, 2402, 2442, 2482, 2522, 2561, 2600, 2638, 2677, 2714, 2751, 2788, 2825, 2861,
+	2896, 2931, 2966, 3000, 3034, 3067, 3100, 3132, 3164, 3196, 3227, 3257, 3287, 3317, 3346, 3374,
+	3402, 3430, 3457, 3483, 3509, 3534, 3559, 3583, 3607, 3630, 3653, 3675, 3697, 3718, 3738, 3758,
+	3777, 3796, 3814, 3832, 3849, 3865, 3881, 3897, 3911, 3925, 3939, 3952, 3964, 3976, 3987, 3998,
+	4007, 4017, 4025, 4034, 4041, 4048, 4054, 4060, 4065, 4069, 4073, 4077, 4079, 4081, 4083, 4083,
+	4083, 4083, 4082, 4080, 4078, 4075, 4071, 4067, 4063, 4057, 4051, 4045, 4037, 4030, 4021, 4012,
+	4003, 3992, 3982, 3970, 3958, 3945, 3932, 3918, 3904, 3889, 3873, 3857, 3841, 3823, 3805, 3787,
+	3768, 3748, 3728, 3707, 3686, 3664, 3642, 3619, 3595, 3571, 3547, 3522, 3496, 3470, 3443, 3416,
+	3388, 3360, 3331, 3302, 3272, 3242, 3211, 3180, 3149, 3116, 3084, 3051, 3017, 2983, 2949, 2914,
+	2878, 2843, 2806, 2770, 2733, 2695, 2658, 2619, 2581, 2542, 2502, 2462, 2422, 2382, 2341, 2300,
+	2258, 2216, 2174, 2131, 2088, 2045, 2002, 1958, 1914, 1869, 1825, 1780, 1734, 1689, 1643, 1597,
+	1551, 1504, 1458, 1411, 1364, 1316, 1269, 1221, 1173, 1125, 1077, 1028, 980, 931, 882, 833,
+	784, 735, 685, 636, 586, 537, 487, 437, 387, 337, 287, 237, 187, 137, 87, 37,
+	12, 62, 112, 162, 212, 262, 312, 362, 412, 462, 512, 562, 611, 661, 710, 759,
+	809, 858, 907, 955, 1004, 1052, 1101, 1149, 1197, 1245, 1292, 1340, 1387, 1434, 1481, 1528,
+	1574, 1620, 1666, 1712, 1757, 1802, 1847, 1891, 1936, 1980, 2023, 2067, 2110, 2153, 2195, 2237,
+	2279, 2320, 2361, 2402, 2442, 2482, 2522, 2561, 2600, 2638, 2677, 2714, 2751, 2788, 2825, 2861,
+	2896, 2931, 2966, 3000, 3034, 3067, 3100, 3132, 3164, 3196, 3227, 3257, 3287, 3317, 3346, 3374,
+	3402, 3430, 3457, 3483, 3509, 3534, 3559, 3583, 3607, 3630, 3653, 3675, 3697, 3718, 3738, 3758,
+	3777, 3796, 3814, 3832, 3849, 3865, 3881, 3897, 3911, 3925, 3939, 3952, 3964, 3976, 3987, 3998,
+	4007, 4017, 4025, 4034, 4041, 4048, 4054, 4060, 4065, 4069, 4073, 4077, 4079, 4081, 4083, 4083,
+	4083, 4083, 4082, 4080, 4078, 4075, 4071, 4067, 4063, 4057, 4051, 4045, 4037, 4030, 4021, 4012,
+	4003, 3992, 3982, 3970, 3958, 3945, 3932, 3918, 3904, 3889, 3873, 3857, 3841, 3823, 3805, 3787,
+	3768, 3748, 3728, 3707, 3686, 3664, 3642, 3619, 3595, 3571, 3547, 3522, 3496, 3470, 3443, 3416,
+	3388, 3360, 3331, 3302, 3272, 3242, 3211, 3180, 3149, 3116, 3084, 3051, 3017, 2983, 2949, 2914,
+	2878, 2843, 2806, 2770, 2733, 2695, 2658, 2619, 2581, 2542, 2502, 2462, 2422, 2382, 2341, 2300,
+	2258, 2216, 2174, 2131, 2088, 2045, 2002, 1958, 1914, 1869, 1825, 1780, 1734, 1689, 1643, 1597,
+	1551, 1504, 1458, 1411, 1364, 1316, 1269, 1221, 1173, 1125, 1077, 1028, 980, 931, 882, 833,
+	784, 735, 685, 636, 586, 537, 487, 437, 387, 337, 287, 237, 187, 137, 87, 37,
+};
+#elif ( DBOPL_WAVE == WAVE_TABLELOG )
+static const Bit16s WaveTable[ 8 * 512 ] = {
+	-30631, -31037, -31225, -31349, -31442, -31516, -31578, -31631, -31677, -31718, -31755, -31789, -31819, -31848, -31874, -31899,
+	-31922, -31943, -31964, -31983, -32001, -32019, -32036, -32051, -32067, -32081, -32096, -32109, -32122, -32135, -32147, -32159,
+	-32170, -32181, -32192, -32202, -32212, -32222, -32232, -32241, -32250, -32259, -32267, -32276, -32284, -32292, -32300, -32307,
+	-32315, -32322, -32329, -32336, -32343, -32350, -32357, -32363, -32369, -32376, -32382, -32388, -32393, -32399, -32405, -32410,
+	-32416, -32421, -32427, -32432, -32437, -32442, -32447, -32452, -32457, -32461, -32466, -32471, -32475, -32479, -32484, -32488,
+	-32492, -32497, -32501, -32505, -32509, -32513, -32517, -32520, -32524, -32528, -32532, -32535, -32539, -32542, -32546, -32549,
+	-32553, -32556, -32559, -32563, -32566, -32569, -32572, -32575, -32578, -32581, -32584, -32587, -32590, -32593, -32596, -32599,
+	-32601, -32604, -32607, -32609, -32612, -32615, -32617, -32620, -32622, -32625, -32627, -32630, -32632, -32634, -32637, -32639,
+	-32641, -32643, -32646, -32648, -32650, -32652, -32654, -32656, -32658, -32660, -32662, -32664, -32666, -32668, -32670, -32672,
+	-32674, -32676, -32677, -32679, -32681, -32683, -32685, -32686, -32688, -32690, -32691, -32693, -32694, -32696, -32698, -32699,
+	-32701, -32702, -32704, -32705, -32706, -32708, -32709, -32711, -32712, -32713, -32715, -32716, -32717, -32719, -32720, -32721,
+	-32722, -32723, -32725, -32726, -32727, -32728, -32729, -32730, -32731, -32732, -32733, -32734, -32735, -32736, -32737, -32738,
+	-32739, -32740, -32741, -32742, -32743, -32744, -32745, -32745, -32746, -32747, -32748, -32748, -32749, -32750, -32751, -32751,
+	-32752, -32753, -32753, -32754, -32755, -32755, -32756, -32756, -32757, -32758, -32758, -32759, -32759, -32760, -32760, -32761,
+	-32761, -32761, -32762, -32762, -32763, -32763, -32763, -32764, -32764, -32764, -32765, -32765, -32765, -32766, -32766, -32766,
+	-32766, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768,
+	-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32766,
+	-32766, -32766, -32766, -32765, -32765, -32765, -32764, -32764, -32764, -32763, -32763, -32763, -32762, -32762, -32761, -32761,
+	-32761, -32760, -32760, -32759, -32759, -32758, -32758, -32757, -32756, -32756, -32755, -32755, -32754, -32753, -32753, -32752,
+	-32751, -32751, -32750, -32749, -32748, -32748, -32747, -32746, -32745, -32745, -32744, -32743, -32742, -32741, -32740, -32739,
+	-32738, -32737, -32736, -32735, -32734, -32733, -32732, -32731, -32730, -32729, -32728, -32727, -32726, -32725, -32723, -32722,
+	-32721, -32720, -32719, -32717, -32716, -32715, -32713, -32712, -32711, -32709, -32708, -32706, -32705, -32704, -32702, -32701,
+	-32699, -32698, -32696, -32694, -32693, -32691, -32690, -32688, -32686, -32685, -32683, -32681, -32679, -32677, -32676, -32674,
+	-32672, -32670, -32668, -32666, -32664, -32662, -32660, -32658, -32656, -32654, -32652, -32650, -32648, -32646, -32643, -32641,
+	-32639, -32637, -32634, -32632, -32630, -32627, -32625, -32622, -32620, -32617, -32615, -32612, -32609, -32607, -32604, -32601,
+	-32599, -32596, -32593, -32590, -32587, -32584, -32581, -32578, -32575, -32572, -32569, -32566, -32563, -32559, -32556, -32553,
+	-32549, -32546, -32542, -32539, -32535, -32532, -32528, -32524, -32520, -32517, -32513, -32509, -32505, -32501, -32497, -32492,
+	-32488, -32484, -32479, -32475, -32471, -32466, -32461, -32457, -32452, -32447, -32442, -32437, -32432, -32427, -32421, -32416,
+	-32410, -32405, -32399, -32393, -32388, -32382, -32376, -32369, -32363, -32357, -32350, -32343, -32336, -32329, -32322, -32315,
+	-32307, -32300, -32292, -32284, -32276, -32267, -32259, -32250, -32241, -32232, -32222, -32212, -32202, -32192, -32181, -32170,
+	-32159, -32147, -32135, -32122, -32109, -32096, -32081, -32067, -32051, -32036, -32019, -32001, -31983, -31964, -31943, -31922,
+	-31899, -31874, -31848, -31819, -31789, -31755, -31718, -31677, -31631, -31578, -31516, -31442, -31349, -31225, -31037, -30631,
+	2137, 1731, 1543, 1419, 1326, 1252, 1190, 1137, 1091, 1050, 1013, 979, 949, 920, 894, 869,
+	846, 825, 804, 785, 767, 749, 732, 717, 701, 687, 672, 659, 646, 633, 621, 609,
+	598, 587, 576, 566, 556, 546, 536, 527, 518, 509, 501, 492, 484, 476, 468, 461,
+	453, 446, 439, 432, 425, 418, 411, 405, 399, 392, 386, 380, 375, 369, 363, 358,
+	352, 347, 341, 336, 331, 326, 321, 316, 311, 307, 302, 297, 293, 289, 284, 280,
+	276, 271, 267, 263, 259, 255, 251, 248, 244, 240, 236, 233, 229, 226, 222, 219,
+	215, 212, 209, 205, 202, 199, 196, 193, 190, 187, 184, 181, 178, 175, 172, 169,
+	167, 164, 161, 159, 156, 153, 151, 148, 146, 143, 141, 138, 136, 134, 131, 129,
+	127, 125, 122, 120, 118, 116, 114, 112, 110, 108, 106, 104, 102, 100, 98, 96,
+	94, 92, 91, 89, 87, 85, 83, 82, 80, 78, 77, 75, 74, 72, 70, 69,
+	67, 66, 64, 63, 62, 60, 59, 57, 56, 55, 53, 52, 51, 49, 48, 47,
+	46, 45, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30,
+	29, 28, 27, 26, 25, 24, 23, 23, 22, 21, 20, 20, 19, 18, 17, 17,
+	16, 15, 15, 14, 13, 13, 12, 12, 11, 10, 10, 9, 9, 8, 8, 7,
+	7, 7, 6, 6, 5, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2,
+	2, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2,
+	2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 6, 6, 7, 7,
+	7, 8, 8, 9, 9, 10, 10, 11, 12, 12, 13, 13, 14, 15, 15, 16,
+	17, 17, 18, 19, 20, 20, 21, 22, 23, 23, 24, 25, 26, 27, 28, 29,
+	30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 45, 46,
+	47, 48, 49, 51, 52, 53, 55, 56, 57, 59, 60, 62, 63, 64, 66, 67,
+	69, 70, 72, 74, 75, 77, 78, 80, 82, 83, 85, 87, 89, 91, 92, 94,
+	96, 98, 100, 102, 104, 106, 108, 110, 112, 114, 116, 118, 120, 122, 125, 127,
+	129, 131, 134, 136, 138, 141, 143, 146, 148, 151, 153, 156, 159, 161, 164, 167,
+	169, 172, 175, 178, 181, 184, 187, 190, 193, 196, 199, 202, 205, 209, 212, 215,
+	219, 222, 226, 229, 233, 236, 240, 244, 248, 251, 255, 259, 263, 267, 271, 276,
+	280, 284, 289, 293, 297, 302, 307, 311, 316, 321, 326, 331, 336, 341, 347, 352,
+	358, 363, 369, 375, 380, 386, 392, 399, 405, 411, 418, 425, 432, 439, 446, 453,
+	461, 468, 476, 484, 492, 501, 509, 518, 527, 536, 546, 556, 566, 576, 587, 598,
+	609, 621, 633, 646, 659, 672, 687, 701, 717, 732, 749, 767, 785, 804, 825, 846,
+	869, 894, 920, 949, 979, 1013, 1050, 1091, 1137, 1190, 1252, 1326, 1419, 1543, 1731, 2137,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30728, -30736, -30744, -30752, -30760, -30768, -30776, -30784, -30792, -30800, -30808, -30816, -30824, -30832, -30840, -30848,
+	-30856, -30864, -30872, -30880, -30888, -30896, -30904, -30912, -30920, -30928, -30936, -30944, -30952, -30960, -30968, -30976,
+	-30984, -30992, -31000, -31008, -31016, -31024, -31032, -31040, -31048, -31056, -31064, -31072, -31080, -31088, -31096, -31104,
+	-31112, -31120, -31128, -31136, -31144, -31152, -31160, -31168, -31176, -31184, -31192, -31200, -31208, -31216, -31224, -31232,
+	-31240, -31248, -31256, -31264, -31272, -31280, -31288, -31296, -31304, -31312, -31320, -31328, -31336, -31344, -31352, -31360,
+	-31368, -31376, -31384, -31392, -31400, -31408, -31416, -31424, -31432, -31440, -31448, -31456, -31464, -31472, -31480, -31488,
+	-31496, -31504, -31512, -31520, -31528, -31536, -31544, -31552, -31560, -31568, -31576, -31584, -31592, -31600, -31608, -31616,
+	-31624, -31632, -31640, -31648, -31656, -31664, -31672, -31680, -31688, -31696, -31704, -31712, -31720, -31728, -31736, -31744,
+	-31752, -31760, -31768, -31776, -31784, -31792, -31800, -31808, -31816, -31824, -31832, -31840, -31848, -31856, -31864, -31872,
+	-31880, -31888, -31896, -31904, -31912, -31920, -31928, -31936, -31944, -31952, -31960, -31968, -31976, -31984, -31992, -32000,
+	-32008, -32016, -32024, -32032, -32040, -32048, -32056, -32064, -32072, -32080, -32088, -32096, -32104, -32112, -32120, -32128,
+	-32136, -32144, -32152, -32160, -32168, -32176, -32184, -32192, -32200, -32208, -32216, -32224, -32232, -32240, -32248, -32256,
+	-32264, -32272, -32280, -32288, -32296, -32304, -32312, -32320, -32328, -32336, -32344, -32352, -32360, -32368, -32376, -32384,
+	-32392, -32400, -32408, -32416, -32424, -32432, -32440, -32448, -32456, -32464, -32472, -32480, -32488, -32496, -32504, -32512,
+	-32520, -32528, -32536, -32544, -32552, -32560, -32568, -32576, -32584, -32592, -32600, -32608, -32616, -32624, -32632, -32640,
+	-32648, -32656, -32664, -32672, -32680, -32688, -32696, -32704, -32712, -32720, -32728, -32736, -32744, -32752, -32760, -32768,
+	0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120,
+	128, 136, 144, 152, 160, 168, 176, 184, 192, 200, 208, 216, 224, 232, 240, 248,
+	256, 264, 272, 280, 288, 296, 304, 312, 320, 328, 336, 344, 352, 360, 368, 376,
+	384, 392, 400, 408, 416, 424, 432, 440, 448, 456, 464, 472, 480, 488, 496, 504,
+	512, 520, 528, 536, 544, 552, 560, 568, 576, 584, 592, 600, 608, 616, 624, 632,
+	640, 648, 656, 664, 672, 680, 688, 696, 704, 712, 720, 728, 736, 744, 752, 760,
+	768, 776, 784, 792, 800, 808, 816, 824, 832, 840, 848, 856, 864, 872, 880, 888,
+	896, 904, 912, 920, 928, 936, 944, 952, 960, 968, 976, 984, 992, 1000, 1008, 1016,
+	1024, 1032, 1040, 1048, 1056, 1064, 1072, 1080, 1088, 1096, 1104, 1112, 1120, 1128, 1136, 1144,
+	1152, 1160, 1168, 1176, 1184, 1192, 1200, 1208, 1216, 1224, 1232, 1240, 1248, 1256, 1264, 1272,
+	1280, 1288, 1296, 1304, 1312, 1320, 1328, 1336, 1344, 1352, 1360, 1368, 1376, 1384, 1392, 1400,
+	1408, 1416, 1424, 1432, 1440, 1448, 1456, 1464, 1472, 1480, 1488, 1496, 1504, 1512, 1520, 1528,
+	1536, 1544, 1552, 1560, 1568, 1576, 1584, 1592, 1600, 1608, 1616, 1624, 1632, 1640, 1648, 1656,
+	1664, 1672, 1680, 1688, 1696, 1704, 1712, 1720, 1728, 1736, 1744, 1752, 1760, 1768, 1776, 1784,
+	1792, 1800, 1808, 1816, 1824, 1832, 1840, 1848, 1856, 1864, 1872, 1880, 1888, 1896, 1904, 1912,
+	1920, 1928, 1936, 1944, 1952, 1960, 1968, 1976, 1984, 1992, 2000, 2008, 2016, 2024, 2032, 2040,
+	2137, 1731, 1543, 1419, 1326, 1252, 1190, 1137, 1091, 1050, 1013, 979, 949, 920, 894, 869,
+	846, 825, 804, 785, 767, 749, 732, 717, 701, 687, 672, 659, 646, 633, 621, 609,
+	598, 587, 576, 566, 556, 546, 536, 527, 518, 509, 501, 492, 484, 476, 468, 461,
+	453, 446, 439, 432, 425, 418, 411, 405, 399, 392, 386, 380, 375, 369, 363, 358,
+	352, 347, 341, 336, 331, 326, 321, 316, 311, 307, 302, 297, 293, 289, 284, 280,
+	276, 271, 267, 263, 259, 255, 251, 248, 244, 240, 236, 233, 229, 226, 222, 219,
+	215, 212, 209, 205, 202, 199, 196, 193, 190, 187, 184, 181, 178, 175, 172, 169,
+	167, 164, 161, 159, 156, 153, 151, 148, 146, 143, 141, 138, 136, 134, 131, 129,
+	127, 125, 122, 120, 118, 116, 114, 112, 110, 108, 106, 104, 102, 100, 98, 96,
+	94, 92, 91, 89, 87, 85, 83, 82, 80, 78, 77, 75, 74, 72, 70, 69,
+	67, 66, 64, 63, 62, 60, 59, 57, 56, 55, 53, 52, 51, 49, 48, 47,
+	46, 45, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30,
+	29, 28, 27, 26, 25, 24, 23, 23, 22, 21, 20, 20, 19, 18, 17, 17,
+	16, 15, 15, 14, 13, 13, 12, 12, 11, 10, 10, 9, 9, 8, 8, 7,
+	7, 7, 6, 6, 5, 5, 5, 4, 4, 4, 3, 3, 3, 2, 2, 2,
+	2, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	2137, 1543, 1326, 1190, 1091, 1013, 949, 894, 846, 804, 767, 732, 701, 672, 646, 621,
+	598, 576, 556, 536, 518, 501, 484, 468, 453, 439, 425, 411, 399, 386, 375, 363,
+	352, 341, 331, 321, 311, 302, 293, 284, 276, 267, 259, 251, 244, 236, 229, 222,
+	215, 209, 202, 196, 190, 184, 178, 172, 167, 161, 156, 151, 146, 141, 136, 131,
+	127, 122, 118, 114, 110, 106, 102, 98, 94, 91, 87, 83, 80, 77, 74, 70,
+	67, 64, 62, 59, 56, 53, 51, 48, 46, 43, 41, 39, 37, 35, 33, 31,
+	29, 27, 25, 23, 22, 20, 19, 17, 16, 15, 13, 12, 11, 10, 9, 8,
+	7, 6, 5, 5, 4, 3, 3, 2, 2, 1, 1, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 4, 4, 5, 6, 7,
+	7, 8, 9, 10, 12, 13, 14, 15, 17, 18, 20, 21, 23, 24, 26, 28,
+	30, 32, 34, 36, 38, 40, 42, 45, 47, 49, 52, 55, 57, 60, 63, 66,
+	69, 72, 75, 78, 82, 85, 89, 92, 96, 100, 104, 108, 112, 116, 120, 125,
+	129, 134, 138, 143, 148, 153, 159, 164, 169, 175, 181, 187, 193, 199, 205, 212,
+	219, 226, 233, 240, 248, 255, 263, 271, 280, 289, 297, 307, 316, 326, 336, 347,
+	358, 369, 380, 392, 405, 418, 432, 446, 461, 476, 492, 509, 527, 546, 566, 587,
+	609, 633, 659, 687, 717, 749, 785, 825, 869, 920, 979, 1050, 1137, 1252, 1419, 1731,
+	-30631, -31225, -31442, -31578, -31677, -31755, -31819, -31874, -31922, -31964, -32001, -32036, -32067, -32096, -32122, -32147,
+	-32170, -32192, -32212, -32232, -32250, -32267, -32284, -32300, -32315, -32329, -32343, -32357, -32369, -32382, -32393, -32405,
+	-32416, -32427, -32437, -32447, -32457, -32466, -32475, -32484, -32492, -32501, -32509, -32517, -32524, -32532, -32539, -32546,
+	-32553, -32559, -32566, -32572, -32578, -32584, -32590, -32596, -32601, -32607, -32612, -32617, -32622, -32627, -32632, -32637,
+	-32641, -32646, -32650, -32654, -32658, -32662, -32666, -32670, -32674, -32677, -32681, -32685, -32688, -32691, -32694, -32698,
+	-32701, -32704, -32706, -32709, -32712, -32715, -32717, -32720, -32722, -32725, -32727, -32729, -32731, -32733, -32735, -32737,
+	-32739, -32741, -32743, -32745, -32746, -32748, -32749, -32751, -32752, -32753, -32755, -32756, -32757, -32758, -32759, -32760,
+	-32761, -32762, -32763, -32763, -32764, -32765, -32765, -32766, -32766, -32767, -32767, -32767, -32768, -32768, -32768, -32768,
+	-32768, -32768, -32768, -32768, -32767, -32767, -32767, -32767, -32766, -32766, -32765, -32764, -32764, -32763, -32762, -32761,
+	-32761, -32760, -32759, -32758, -32756, -32755, -32754, -32753, -32751, -32750, -32748, -32747, -32745, -32744, -32742, -32740,
+	-32738, -32736, -32734, -32732, -32730, -32728, -32726, -32723, -32721, -32719, -32716, -32713, -32711, -32708, -32705, -32702,
+	-32699, -32696, -32693, -32690, -32686, -32683, -32679, -32676, -32672, -32668, -32664, -32660, -32656, -32652, -32648, -32643,
+	-32639, -32634, -32630, -32625, -32620, -32615, -32609, -32604, -32599, -32593, -32587, -32581, -32575, -32569, -32563, -32556,
+	-32549, -32542, -32535, -32528, -32520, -32513, -32505, -32497, -32488, -32479, -32471, -32461, -32452, -32442, -32432, -32421,
+	-32410, -32399, -32388, -32376, -32363, -32350, -32336, -32322, -32307, -32292, -32276, -32259, -32241, -32222, -32202, -32181,
+	-32159, -32135, -32109, -32081, -32051, -32019, -31983, -31943, -31899, -31848, -31789, -31718, -31631, -31516, -31349, -31037,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	-30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631, -30631,
+	2137, 1543, 1326, 1190, 1091, 1013, 949, 894, 846, 804, 767, 732, 701, 672, 646, 621,
+	598, 576, 556, 536, 518, 501, 484, 468, 453, 439, 425, 411, 399, 386, 375, 363,
+	352, 341, 331, 321, 311, 302, 293, 284, 276, 267, 259, 251, 244, 236, 229, 222,
+	215, 209, 202, 196, 190, 184, 178, 172, 167, 161, 156, 151, 146, 141, 136, 131,
+	127, 122, 118, 114, 110, 106, 102, 98, 94, 91, 87, 83, 80, 77, 74, 70,
+	67, 64, 62, 59, 56, 53, 51, 48, 46, 43, 41, 39, 37, 35, 33, 31,
+	29, 27, 25, 23, 22, 20, 19, 17, 16, 15, 13, 12, 11, 10, 9, 8,
+	7, 6, 5, 5, 4, 3, 3, 2, 2, 1, 1, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 4, 4, 5, 6, 7,
+	7, 8, 9, 10, 12, 13, 14, 15, 17, 18, 20, 21, 23, 24, 26, 28,
+	30, 32, 34, 36, 38, 40, 42, 45, 47, 49, 52, 55, 57, 60, 63, 66,
+	69, 72, 75, 78, 82, 85, 89, 92, 96, 100, 104, 108, 112, 116, 120, 125,
+	129, 134, 138, 143, 148, 153, 159, 164, 169, 175, 181, 187, 193, 199, 205, 212,
+	219, 226, 233, 240, 248, 255, 263, 271, 280, 289, 297, 307, 316, 326, 336, 347,
+	358, 369, 380, 392, 405, 418, 432, 446, 461, 476, 492, 509, 527, 546, 566, 587,
+	609, 633, 659, 687, 717, 749, 785, 825, 869, 920, 979, 1050, 1137, 1252, 1419, 1731,
+	2137, 1543, 1326, 1190, 1091, 1013, 949, 894, 846, 804, 767, 732, 701, 672, 646, 621,
+	598, 576, 556, 536, 518, 501, 484, 468, 453, 439, 425, 411, 399, 386, 375, 363,
+	352, 341, 331, 321, 311, 302, 293, 284, 276, 267, 259, 251, 244, 236, 229, 222,
+	215, 209, 202, 196, 190, 184, 178, 172, 167, 161, 156, 151, 146, 141, 136, 131,
+	127, 122, 118, 114, 110, 106, 102, 98, 94, 91, 87, 83, 80, 77, 74, 70,
+	67, 64, 62, 59, 56, 53, 51, 48, 46, 43, 41, 39, 37, 35, 33, 31,
+	29, 27, 25, 23, 22, 20, 19, 17, 16, 15, 13, 12, 11, 10, 9, 8,
+	7, 6, 5, 5, 4, 3, 3, 2, 2, 1, 1, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 4, 4, 5, 6, 7,
+	7, 8, 9, 10, 12, 13, 14, 15, 17, 18, 20, 21, 23, 24, 26, 28,
+	30, 32, 34, 36, 38, 40, 42, 45, 47, 49, 52, 55, 57, 60, 63, 66,
+	69, 72, 75, 78, 82, 85, 89, 92, 96, 100, 104, 108, 112, 116, 120, 125,
+	129, 134, 138, 143, 148, 153, 159, 164, 169, 175, 181, 187, 193, 199, 205, 212,
+	219, 226, 233, 240, 248, 255, 263, 271, 280, 289, 297, 307, 316, 326, 336, 347,
+	358, 369, 380, 392, 405, 418, 432, 446, 461, 476, 492, 509, 527, 546, 566, 587,
+	609, 633, 659, 687, 717, 749, 785, 825, 869, 920, 979, 1050, 1137, 1252, 1419, 1731,
+};
+#endif
+
+#if ( DBOPL_WAVE == WAVE_TABLEMUL )
+static const Bit16u MulTable[ 384 ] = {
+	65359, 63958, 62588, 61247, 59934, 58650, 57393, 56163, 54960, 53782, 52630, 51502, 50399, 49319, 48262, 47228,
+	46216, 45225, 44256, 43308, 42380, 41472, 40583, 39714, 38863, 38030, 37215, 36417, 35637, 34874, 34126, 33395,
+	32679, 31979, 31294, 30623, 29967, 29325, 28697, 28082, 27480, 26891, 26315, 25751, 25199, 24659, 24131, 23614,
+	23108, 22613, 22128, 21654, 21190, 20736, 20292, 19857, 19431, 19015, 18607, 18209, 17819, 17437, 17063, 16697,
+	16340, 15990, 15647, 15312, 14984, 14663, 14348, 14041, 13740, 13446, 13157, 12876, 12600, 12330, 12065, 11807,
+	11554, 11306, 11064, 10827, 10595, 10368, 10146, 9928, 9716, 9507, 9304, 9104, 8909, 8718, 8532, 8349,
+	8170, 7995, 7823, 7656, 7492, 7331, 7174, 7020, 6870, 6723, 6579, 6438, 6300, 6165, 6033, 5903,
+	5777, 5653, 5532, 5413, 5297, 5184, 5073, 4964, 4858, 4754, 4652, 4552, 4455, 4359, 4266, 4174,
+	4085, 3997, 3912, 3828, 3746, 3666, 3587, 3510, 3435, 3361, 3289, 3219, 3150, 3082, 3016, 2952,
+	2888, 2827, 2766, 2707, 2649, 2592, 2536, 2482, 2429, 2377, 2326, 2276, 2227, 2180, 2133, 2087,
+	2042, 1999, 1956, 1914, 1873, 1833, 1794, 1755, 1717, 1681, 1645, 1609, 1575, 1541, 1508, 1476,
+	1444, 1413, 1383, 1353, 1324, 1296, 1268, 1241, 1214, 1188, 1163, 1138, 1114, 1090, 1066, 1044,
+	1021, 999, 978, 957, 936, 916, 897, 878, 859, 840, 822, 805, 787, 771, 754, 738,
+	722, 707, 692, 677, 662, 648, 634, 621, 607, 594, 581, 569, 557, 545, 533, 522,
+	511, 500, 489, 478, 468, 458, 448, 439, 429, 420, 411, 402, 394, 385, 377, 369,
+	361, 353, 346, 338, 331, 324, 317, 310, 304, 297, 291, 285, 278, 272, 267, 261,
+	255, 250, 244, 239, 234, 229, 224, 219, 215, 210, 206, 201, 197, 193, 189, 184,
+	181, 177, 173, 169, 166, 162, 159, 155, 152, 149, 145, 142, 139, 136, 133, 130,
+	128, 125, 122, 120, 117, 115, 112, 110, 107, 105, 103, 101, 98, 96, 94, 92,
+	90, 88, 86, 85, 83, 81, 79, 78, 76, 74, 73, 71, 70, 68, 67, 65,
+	64, 62, 61, 60, 59, 57, 56, 55, 54, 53, 51, 50, 49, 48, 47, 46,
+	45, 44, 43, 42, 41, 40, 40, 39, 38, 37, 36, 36, 35, 34, 33, 33,
+	32, 31, 31, 30, 29, 29, 28, 27, 27, 26, 26, 25, 25, 24, 24, 23,
+	23, 22, 22, 21, 21, 20, 20, 19, 19, 19, 18, 18, 17, 17, 17, 16,
+};
+//WaveTable widened to 32 bits, so the lane generator can gather from it
+static const Bit32s LaneWaveTable[ 8 * 512 ] = {
+	-12, -37, -62, -87, -112, -137, -162, -187, -212, -237, -262, -287, -312, -337, -362, -387,
+	-412, -437, -462, -487, -512, -537, -562, -586, -611, -636, -661, -685, -710, -735, -759, -784,
+	-809, -833, -858, -882, -907, -931, -955, -980, -1004, -1028, -1052, -1077, -1101, -1125, -1149, -1173,
+	-1197, -1221, -1245, -1269, -1292, -1316, -1340, -1364, -1387, -1411, -1434, -1458, -1481, -1504, -1528, -1551,
+	-1574, -1597, -1620, -1643, -1666, -1689, -1712, -1734, -1757, -1780, -1802, -1825, -1847, -1869, -1891, -1914,
+	-1936, -1958, -1980, -2002, -2023, -2045, -2067, -2088, -2110, -2131, -2153, -2174, -2195, -2216, -2237, -2258,
+	-2279, -2300, -2320, -2341, -2361, -2382, -2402, -2422, -2442, -2462, -2482, -2502, -2522, -2542, -2561, -2581,
+	-2600, -2619, -2638, -2658, -2677, -2695, -2714, -2733, -2751, -2770, -2788, -2806, -2825, -2843, -2861, -2878,
+	-2896, -2914, -2931, -2949, -2966, -2983, -3000, -3017, -3034, -3051, -3067, -3084, -3100, -3116, -3132, -3149,
+	-3164, -3180, -3196, -3211, -3227, -3242, -3257, -3272, -3287, -3302, -3317, -3331, -3346, -3360, -3374, -3388,
+	-3402, -3416, -3430, -3443, -3457, -3470, -3483, -3496, -3509, -3522, -3534, -3547, -3559, -3571, -3583, -3595,
+	-3607, -3619, -3630, -3642, -3653, -3664, -3675, -3686, -3697, -3707, -3718, -3728, -3738, -3748, -3758, -3768,
+	-3777, -3787, -3796, -3805, -3814, -3823, -3832, -3841, -3849, -3857, -3865, -3873, -3881, -3889, -3897, -3904,
+	-3911, -3918, -3925, -3932, -3939, -3945, -3952, -3958, -3964, -3970, -3976, -3982, -3987, -3992, -3998, -4003,
+	-4007, -4012, -4017, -4021, -4025, -4030, -4034, -4037, -4041, -4045, -4048, -4051, -4054, -4057, -4060, -4063,
+	-4065, -4067, -4069, -4071, -4073, -4075, -4077, -4078, -4079, -4080, -4081, -4082, -4083, -4083, -4083, -4083,
+	-4083, -4083, -4083, -4083, -4082, -4081, -4080, -4079, -4078, -4077, -4075, -4073, -4071, -4069, -4067, -4065,
+	-4063, -4060, -4057, -4054, -4051, -4048, -4045, -4041, -4037, -4034, -4030, -4025, -4021, -4017, -4012, -4007,
+	-4003, -3998, -3992, -3987, -3982, -3976, -3970, -3964, -3958, -3952, -3945, -3939, -3932, -3925, -3918, -3911,
+	-3904, -3897, -3889, -3881, -3873, -3865, -3857, -3849, -3841, -3832, -3823, -3814, -3805, -3796, -3787, -3777,
+	-3768, -3758, -3748, -3738, -3728, -3718, -3707, -3697, -3686, -3675, -3664, -3653, -3642, -3630, -3619, -3607,
+	-3595, -3583, -3571, -3559, -3547, -3534, -3522, -3509, -3496, -3483, -3470, -3457, -3443, -3430, -3416, -3402,
+	-3388, -3374, -3360, -3346, -3331, -3317, -3302, -3287, -3272, -3257, -3242, -3227, -3211, -3196, -3180, -3164,
+	-3149, -3132, -3116, -3100, -3084, -3067, -3051, -3034, -3017, -3000, -2983, -2966, -2949, -2931, -2914, -2896,
+	-2878, -2861, -2843, -2825, -2806, -2788, -2770, -2751, -2733, -2714, -2695, -2677, -2658, -2638, -2619, -2600,
+	-2581, -2561, -2542, -2522, -2502, -2482, -2462, -2442, -2422, -2402, -2382, -2361, -2341, -2320, -2300, -2279,
+	-2258, -2237, -2216, -2195, -2174, -2153, -2131, -2110, -2088, -2067, -2045, -2023, -2002, -1980, -1958, -1936,
+	-1914, -1891, -1869, -1847, -1825, -1802, -1780, -1757, -1734, -1712, -1689, -1666, -1643, -1620, -1597, -1574,
+	-1551, -1528, -1504, -1481, -1458, -1434, -1411, -1387, -1364, -1340, -1316, -1292, -1269, -1245, -1221, -1197,
+	-1173, -1149, -1125, -1101, -1077, -1052, -1028, -1004, -980, -955, -931, -907, -882, -858, -833, -809,
+	-784, -759, -735, -710, -685, -661, -636, -611, -586, -562, -537, -512, -487, -462, -437, -412,
+	-387, -362, -337, -312, -287, -262, -237, -212, -187, -162, -137, -112, -87, -62, -37, -12,
+	12, 37, 62, 87, 112, 137, 162, 187, 212, 237, 262, 287, 312, 337, 362, 387,
+	412, 437, 462, 487, 512, 537, 562, 586, 611, 636, 661, 685, 710, 735, 759, 784,
+	809, 833, 858, 882, 907, 931, 955, 980, 1004, 1028, 1052, 1077, 1101, 1125, 1149, 1173,
+	1197, 1221, 1245, 1269, 1292, 1316, 1340, 1364, 1387, 1411, 1434, 1458, 1481, 1504, 1528, 1551,
+	1574, 1597, 1620, 1643, 1666, 1689, 1712, 1734, 1757, 1780, 1802, 1825, 1847, 1869, 1891, 1914,
+	1936, 1958, 1980, 2002, 2023, 2045, 2067, 2088, 2110, 2131, 2153, 2174, 2195, 2216, 2237, 2258,
+	2279, 2300, 2320, 2341, 2361, 2382, 2402, 2422, 2442, 2462, 2482, 2502, 2522, 2542, 2561, 2581,
+	2600, 2619, 2638, 2658, 2677, 2695, 2714, 2733, 2751, 2770, 2788, 2806, 2825, 2843, 2861, 2878,
+	2896, 2914, 2931, 2949, 2966, 2983, 3000, 3017, 3034, 3051, 3067, 3084, 3100, 3116, 3132, 3149,
+	3164, 3180, 3196, 3211, 3227, 3242, 3257, 3272, 3287, 3302, 3317, 3331, 3346, 3360, 3374, 3388,
+	3402, 3416, 3430, 3443, 3457, 3470, 3483, 3496, 3509, 3522, 3534, 3547, 3559, 3571, 3583, 3595,
+	3607, 3619, 3630, 3642, 3653, 3664, 3675, 3686, 3697, 3707, 3718, 3728, 3738, 3748, 3758, 3768,
+	3777, 3787, 3796, 3805, 3814, 3823, 3832, 3841, 3849, 3857, 3865, 3873, 3881, 3889, 3897, 3904,
+	3911, 3918, 3925, 3932, 3939, 3945, 3952, 3958, 3964, 3970, 3976, 3982, 3987, 3992, 3998, 4003,
+	4007, 4012, 4017, 4021, 4025, 4030, 4034, 4037, 4041, 4045, 4048, 4051, 4054, 4057, 4060, 4063,
+	4065, 4067, 4069, 4071, 4073, 4075, 4077, 4078, 4079, 4080, 4081, 4082, 4083, 4083, 4083, 4083,
+	4083, 4083, 4083, 4083, 4082, 4081, 4080, 4079, 4078, 4077, 4075, 4073, 4071, 4069, 4067, 4065,
+	4063, 4060, 4057, 4054, 4051, 4048, 4045, 4041, 4037, 4034, 4030, 4025, 4021, 4017, 4012, 4007,
+	4003, 3998, 3992, 3987, 3982, 3976, 3970, 3964, 3958, 3952, 3945, 3939, 3932, 3925, 3918, 3911,
+	3904, 3897, 3889, 3881, 3873, 3865, 3857, 3849, 3841, 3832, 3823, 3814, 3805, 3796, 3787, 3777,
+	3768, 3758, 3748, 3738, 3728, 3718, 3707, 3697, 3686, 3675, 3664, 3653, 3642, 3630, 3619, 3607,
+	3595, 3583, 3571, 3559, 3547, 3534, 3522, 3509, 3496, 3483, 3470, 3457, 3443, 3430, 3416, 3402,
+	3388, 3374, 3360, 3346, 3331, 3317, 3302, 3287, 3272, 3257, 3242, 3227, 3211, 3196, 3180, 3164,
+	3149, 3132, 3116, 3100, 3084, 3067, 3051, 3034, 3017, 3000, 2983, 2966, 2949, 2931, 2914, 2896,
+	2878, 2861, 2843, 2825, 2806, 2788, 2770, 2751, 2733, 2714, 2695, 2677, 2658, 2638, 2619, 2600,
+	2581, 2561, 2542, 2522, 2502, 2482, 2462, 2442, 2422, 2402, 2382, 2361, 2341, 2320, 2300, 2279,
+	2258, 2237, 2216, 2195, 2174, 2153, 2131, 2110, 2088, 2067, 2045, 2023, 2002, 1980, 1958, 1936,
+	1914, 1891, 1869, 1847, 1825, 1802, 1780, 1757, 1734, 1712, 1689, 1666, 1643, 1620, 1597, 1574,
+	1551, 1528, 1504, 1481, 1458, 1434, 1411, 1387, 1364, 1340, 1316, 1292, 1269, 1245, 1221, 1197,
+	1173, 1149, 1125, 1101, 1077, 1052, 1028, 1004, 980, 955, 931, 907, 882, 858, 833, 809,
+	784, 759, 735, 710, 685, 661, 636, 611, 586, 562, 537, 512, 487, 462, 437, 412,
+	387, 362, 337, 312, 287, 262, 237, 212, 187, 162, 137, 112, 87, 62, 37, 12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-16, -17, -17, -17, -18, -18, -19, -19, -19, -20, -20, -21, -21, -22, -22, -23,
+	-23, -24, -24, -25, -25, -26, -26, -27, -27, -28, -29, -29, -30, -30, -31, -32,
+	-33, -33, -34, -35, -35, -36, -37, -38, -39, -40, -40, -41, -42, -43, -44, -45,
+	-46, -47, -48, -49, -50, -51, -52, -54, -55, -56, -57, -58, -60, -61, -62, -64,
+	-65, -66, -68, -69, -71, -72, -74, -76, -77, -79, -81, -83, -84, -86, -88, -90,
+	-92, -94, -96, -98, -100, -103, -105, -107, -109, -112, -114, -117, -119, -122, -125, -127,
+	-130, -133, -136, -139, -142, -145, -148, -151, -155, -158, -162, -165, -169, -172, -176, -180,
+	-184, -188, -192, -196, -201, -205, -210, -214, -219, -224, -228, -233, -239, -244, -249, -255,
+	-260, -266, -272, -278, -284, -290, -296, -303, -309, -316, -323, -330, -337, -345, -352, -360,
+	-368, -376, -384, -393, -401, -410, -419, -428, -438, -447, -457, -467, -477, -488, -498, -509,
+	-520, -532, -543, -555, -567, -580, -593, -606, -619, -632, -646, -660, -675, -690, -705, -720,
+	-736, -752, -769, -785, -803, -820, -838, -856, -875, -894, -914, -934, -954, -975, -997, -1018,
+	-1041, -1064, -1087, -1111, -1135, -1160, -1185, -1211, -1238, -1265, -1293, -1321, -1350, -1379, -1409, -1440,
+	-1472, -1504, -1537, -1571, -1605, -1640, -1676, -1713, -1750, -1789, -1828, -1868, -1909, -1951, -1993, -2037,
+	-2082, -2127, -2174, -2221, -2270, -2320, -2370, -2422, -2475, -2530, -2585, -2642, -2699, -2759, -2819, -2881,
+	-2944, -3008, -3074, -3141, -3210, -3281, -3352, -3426, -3501, -3577, -3656, -3736, -3818, -3901, -3987, -4074,
+	4074, 3987, 3901, 3818, 3736, 3656, 3577, 3501, 3426, 3352, 3281, 3210, 3141, 3074, 3008, 2944,
+	2881, 2819, 2759, 2699, 2642, 2585, 2530, 2475, 2422, 2370, 2320, 2270, 2221, 2174, 2127, 2082,
+	2037, 1993, 1951, 1909, 1868, 1828, 1789, 1750, 1713, 1676, 1640, 1605, 1571, 1537, 1504, 1472,
+	1440, 1409, 1379, 1350, 1321, 1293, 1265, 1238, 1211, 1185, 1160, 1135, 1111, 1087, 1064, 1041,
+	1018, 997, 975, 954, 934, 914, 894, 875, 856, 838, 820, 803, 785, 769, 752, 736,
+	720, 705, 690, 675, 660, 646, 632, 619, 606, 593, 580, 567, 555, 543, 532, 520,
+	509, 498, 488, 477, 467, 457, 447, 438, 428, 419, 410, 401, 393, 384, 376, 368,
+	360, 352, 345, 337, 330, 323, 316, 309, 303, 296, 290, 284, 278, 272, 266, 260,
+	255, 249, 244, 239, 233, 228, 224, 219, 214, 210, 205, 201, 196, 192, 188, 184,
+	180, 176, 172, 169, 165, 162, 158, 155, 151, 148, 145, 142, 139, 136, 133, 130,
+	127, 125, 122, 119, 117, 114, 112, 109, 107, 105, 103, 100, 98, 96, 94, 92,
+	90, 88, 86, 84, 83, 81, 79, 77, 76, 74, 72, 71, 69, 68, 66, 65,
+	64, 62, 61, 60, 58, 57, 56, 55, 54, 52, 51, 50, 49, 48, 47, 46,
+	45, 44, 43, 42, 41, 40, 40, 39, 38, 37, 36, 35, 35, 34, 33, 33,
+	32, 31, 30, 30, 29, 29, 28, 27, 27, 26, 26, 25, 25, 24, 24, 23,
+	23, 22, 22, 21, 21, 20, 20, 19, 19, 19, 18, 18, 17, 17, 17, 16,
+	12, 37, 62, 87, 112, 137, 162, 187, 212, 237, 262, 287, 312, 337, 362, 387,
+	412, 437, 462, 487, 512, 537, 562, 586, 611, 636, 661, 685, 710, 735, 759, 784,
+	809, 833, 858, 882, 907, 931, 955, 980, 1004, 1028, 1052, 1077, 1101, 1125, 1149, 1173,
+	1197, 1221, 1245, 1269, 1292, 1316, 1340, 1364, 1387, 1411, 1434, 1458, 1481, 1504, 1528, 1551,
+	1574, 1597, 1620, 1643, 1666, 1689, 1712, 1734, 1757, 1780, 1802, 1825, 1847, 1869, 1891, 1914,
+	1936, 1958, 1980, 2002, 2023, 2045, 2067, 2088, 2110, 2131, 2153, 2174, 2195, 2216, 2237, 2258,
+	2279, 2300, 2320, 2341, 2361, 2382, 2402, 2422, 2442, 2462, 2482, 2502, 2522, 2542, 2561, 2581,
+	2600, 2619, 2638, 2658, 2677, 2695, 2714, 2733, 2751, 2770, 2788, 2806, 2825, 2843, 2861, 2878,
+	2896, 2914, 2931, 2949, 2966, 2983, 3000, 3017, 3034, 3051, 3067, 3084, 3100, 3116, 3132, 3149,
+	3164, 3180, 3196, 3211, 3227, 3242, 3257, 3272, 3287, 3302, 3317, 3331, 3346, 3360, 3374, 3388,
+	3402, 3416, 3430, 3443, 3457, 3470, 3483, 3496, 3509, 3522, 3534, 3547, 3559, 3571, 3583, 3595,
+	3607, 3619, 3630, 3642, 3653, 3664, 3675, 3686, 3697, 3707, 3718, 3728, 3738, 3748, 3758, 3768,
+	3777, 3787, 3796, 3805, 3814, 3823, 3832, 3841, 3849, 3857, 3865, 3873, 3881, 3889, 3897, 3904,
+	3911, 3918, 3925, 3932, 3939, 3945, 3952, 3958, 3964, 3970, 3976, 3982, 3987, 3992, 3998, 4003,
+	4007, 4012, 4017, 4021, 4025, 4030, 4034, 4037, 4041, 4045, 4048, 4051, 4054, 4057, 4060, 4063,
+	4065, 4067, 4069, 4071, 4073, 4075, 4077, 4078, 4079, 4080, 4081, 4082, 4083, 4083, 4083, 4083,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	12, 62, 112, 162, 212, 262, 312, 362, 412, 462, 512, 562, 611, 661, 710, 759,
+	809, 858, 907, 955, 1004, 1052, 1101, 1149, 1197, 1245, 1292, 1340, 1387, 1434, 1481, 1528,
+	1574, 1620, 1666, 1712, 1757, 1802, 1847, 1891, 1936, 1980, 2023, 2067, 2110, 2153, 2195, 2237,
+	2279, 2320, 2361, 2402, 2442, 2482, 2522, 2561, 2600, 2638, 2677, 2714, 2751, 2788, 2825, 2861,
+	2896, 2931, 2966, 3000, 3034, 3067, 3100, 3132, 3164, 3196, 3227, 3257, 3287, 3317, 3346, 3374,
+	3402, 3430, 3457, 3483, 3509, 3534, 3559, 3583, 3607, 3630, 3653, 3675, 3697, 3718, 3738, 3758,
+	3777, 3796, 3814, 3832, 3849, 3865, 3881, 3897, 3911, 3925, 3939, 3952, 3964, 3976, 3987, 3998,
+	4007, 4017, 4025, 4034, 4041, 4048, 4054, 4060, 4065, 4069, 4073, 4077, 4079, 4081, 4083, 4083,
+	4083, 4083, 4082, 4080, 4078, 4075, 4071, 4067, 4063, 4057, 4051, 4045, 4037, 4030, 4021, 4012,
+	4003, 3992, 3982, 3970, 3958, 3945, 3932, 3918, 3904, 3889, 3873, 3857, 3841, 3823, 3805, 3787,
+	3768, 3748, 3728, 3707, 3686, 3664, 3642, 3619, 3595, 3571, 3547, 3522, 3496, 3470, 3443, 3416,
+	3388, 3360, 3331, 3302, 3272, 3242, 3211, 3180, 3149, 3116, 3084, 3051, 3017, 2983, 2949, 2914,
+	2878, 2843, 2806, 2770, 2733, 2695, 2658, 2619, 2581, 2542, 2502, 2462, 2422, 2382, 2341, 2300,
+	2258, 2216, 2174, 2131, 2088, 2045, 2002, 1958, 1914, 1869, 1825, 1780, 1734, 1689, 1643, 1597,
+	1551, 1504, 1458, 1411, 1364, 1316, 1269, 1221, 1173, 1125, 1077, 1028, 980, 931, 882, 833,
+	784, 735, 685, 636, 586, 537, 487, 437, 387, 337, 287, 237, 187, 137, 87, 37,
+	-12, -62, -112, -162, -212, -262, -312, -362, -412, -462, -512, -562, -611, -661, -710, -759,
+	-809, -858, -907, -955, -1004, -1052, -1101, -1149, -1197, -1245, -1292, -1340, -1387, -1434, -1481, -1528,
+	-1574, -1620, -1666, -1712, -1757, -1802, -1847, -1891, -1936, -1980, -2023, -2067, -2110, -2153, -2195, -2237,
+	-2279, -2320, -2361, -2402, -2442, -2482, -2522, -2561, -2600, -2638, -2677, -2714, -2751, -2788, -2825, -2861,
+	-2896, -2931, -2966, -3000, -3034, -3067, -3100, -3132, -3164, -3196, -3227, -3257, -3287, -3317, -3346, -3374,
+	-3402, -3430, -3457, -3483, -3509, -3534, -3559, -3583, -3607, -3630, -3653, -3675, -3697, -3718, -3738, -3758,
+	-3777, -3796, -3814, -3832, -3849, -3865, -3881, -3897, -3911, -3925, -3939, -3952, -3964, -3976, -3987, -3998,
+	-4007, -4017, -4025, -4034, -4041, -4048, -4054, -4060, -4065, -4069, -4073, -4077, -4079, -4081, -4083, -4083,
+	-4083, -4083, -4082, -4080, -4078, -4075, -4071, -4067, -4063, -4057, -4051, -4045, -4037, -4030, -4021, -4012,
+	-4003, -3992, -3982, -3970, -3958, -3945, -3932, -3918, -3904, -3889, -3873, -3857, -3841, -3823, -3805, -3787,
+	-3768, -3748, -3728, -3707, -3686, -3664, -3642, -3619, -3595, -3571, -3547, -3522, -3496, -3470, -3443, -3416,
+	-3388, -3360, -3331, -3302, -3272, -3242, -3211, -3180, -3149, -3116, -3084, -3051, -3017, -2983, -2949, -2914,
+	-2878, -2843, -2806, -2770, -2733, -2695, -2658, -2619, -2581, -2542, -2502, -2462, -2422, -2382, -2341, -2300,
+	-2258, -2216, -2174, -2131, -2088, -2045, -2002, -1958, -1914, -1869, -1825, -1780, -1734, -1689, -1643, -1597,
+	-1551, -1504, -1458, -1411, -1364, -1316, -1269, -1221, -1173, -1125, -1077, -1028, -980, -931, -882, -833,
+	-784, -735, -685, -636, -586, -537, -487, -437, -387, -337, -287, -237, -187, -137, -87, -37,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	-12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12, -12,
+	12, 62, 112, 162, 212, 262, 312, 362, 412, 462, 512, 562, 611, 661, 710, 759,
+	809, 858, 907, 955, 1004, 1052, 1101, 1149, 1197, 1245, 1292, 1340, 1387, 1434, 1481, 1528,
+	1574, 1620, 1666, 1712, 1757, 1802, 1847, 1891, 1936, 1980, 2023, 2067, 2110, 2153, 2195, 2237,
+	2279, 2320, 2361, 2402, 2442, 2482, 2522, 2561, 2600, 2638, 2677, 2714, 2751, 2788, 2825, 2861,
+	2896, 2931, 2966, 3000, 3034, 3067, 3100, 3132, 3164, 3196, 3227, 3257, 3287, 3317, 3346, 3374,
+	3402, 3430, 3457, 3483, 3509, 3534, 3559, 3583, 3607, 3630, 3653, 3675, 3697, 3718, 3738, 3758,
+	3777, 3796, 3814, 3832, 3849, 3865, 3881, 3897, 3911, 3925, 3939, 3952, 3964, 3976, 3987, 3998,
+	4007, 4017, 4025, 4034, 4041, 4048, 4054, 4060, 4065, 4069, 4073, 4077, 4079, 4081, 4083, 4083,
+	4083, 4083, 4082, 4080, 4078, 4075, 4071, 4067, 4063, 4057, 4051, 4045, 4037, 4030, 4021, 4012,
+	4003, 3992, 3982, 3970, 3958, 3945, 3932, 3918, 3904, 3889, 3873, 3857, 3841, 3823, 3805, 3787,
+	3768, 3748, 3728, 3707, 3686, 3664, 3642, 3619, 3595, 3571, 3547, 3522, 3496, 3470, 3443, 3416,
+	3388, 3360, 3331, 3302, 3272, 3242, 3211, 3180, 3149, 3116, 3084, 3051, 3017, 2983, 2949, 2914,
+	2878, 2843, 2806, 2770, 2733, 2695, 2658, 2619, 2581, 2542, 2502, 2462, 2422, 2382, 2341, 2300,
+	2258, 2216, 2174, 2131, 2088, 2045, 2002, 1958, 1914, 1869, 1825, 1780, 1734, 1689, 1643, 1597,
+	1551, 1504, 1458, 1411, 1364, 1316, 1269, 1221, 1173, 1125, 1077, 1028, 980, 931, 882, 833,
+	784, 735, 685, 636, 586, 537, 487, 437, 387, 337, 287, 237, 187, 137, 87, 37,
+	12, 62, 112, 162, 212, 262, 312, 362, 412, 462, 512, 562, 611, 661, 710, 759,
+	809, 858, 907, 955, 1004, 1052, 1101, 1149, 1197, 1245, 1292, 1340, 1387, 1434, 1481, 1528,
+	1574, 1620, 1666, 1712, 1757, 1802, 1847, 1891, 1936, 1980, 2023, 2067, 2110, 2153, 2195, 2237,
+	2279, 2320, 2361, 2402, 2442, 2482, 2522, 2561, 2600, 2638, 2677, 2714, 2751, 2788, 2825, 2861,
+	2896, 2931, 2966, 3000, 3034, 3067, 3100, 3132, 3164, 3196, 3227, 3257, 3287, 3317, 3346, 3374,
+	3402, 3430, 3457, 3483, 3509, 3534, 3559, 3583, 3607, 3630, 3653, 3675, 3697, 3718, 3738, 3758,
+	3777, 3796, 3814, 3832, 3849, 3865, 3881, 3897, 3911, 3925, 3939, 3952, 3964, 3976, 3987, 3998,
+	4007, 4017, 4025, 4034, 4041, 4048, 4054, 4060, 4065, 4069, 4073, 4077, 4079, 4081, 4083, 4083,
+	4083, 4083, 4082, 4080, 4078, 4075, 4071, 4067, 4063, 4057, 4051, 4045, 4037, 4030, 4021, 4012,
+	4003, 3992, 3982, 3970, 3958, 3945, 3932, 3918, 3904, 3889, 3873, 3857, 3841, 3823, 3805, 3787,
+	3768, 3748, 3728, 3707, 3686, 3664, 3642, 3619, 3595, 3571, 3547, 3522, 3496, 3470, 3443, 3416,
+	3388, 3360, 3331, 3302, 3272, 3242, 3211, 3180, 3149, 3116, 3084, 3051, 3017, 2983, 2949, 2914,
+	2878, 2843, 2806, 2770, 2733, 2695, 2658, 2619, 2581, 2542, 2502, 2462, 2422, 2382, 2341, 2300,
+	2258, 2216, 2174, 2131, 2088, 2045, 2002, 1958, 1914, 1869, 1825, 1780, 1734, 1689, 1643, 1597,
+	1551, 1504, 1458, 1411, 1364, 1316, 1269, 1221, 1173, 1125, 1077, 1028, 980, 931, 882, 833,
+	784, 735, 685, 636, 586, 537, 487, 437, 387, 337, 287, 237, 187, 137, 87, 37,
+};
+#endif
+
+static const Bit8u KslTable[ 8 * 16 ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 12, 16, 20, 24, 28, 32,
+	0, 0, 0, 0, 0, 16, 20, 24, 32, 40, 44, 48, 52, 56, 60, 64,
+	0, 0, 0, 20, 32, 48, 52, 56, 64, 72, 76, 80, 84, 88, 92, 96,
+	0, 0, 32, 52, 64, 80, 84, 88, 96, 104, 108, 112, 116, 120, 124, 128,
+	0, 32, 64, 84, 96, 112, 116, 120, 128, 136, 140, 144, 148, 152, 156, 160,
+	0, 64, 96, 116, 128, 144, 148, 152, 160, 168, 172, 176, 180, 184, 188, 192,
+	0, 96, 128, 148, 160, 176, 180, 184, 192, 200, 204, 208, 212, 216, 220, 224,
+};
+static const Bit8u TremoloTable[ TREMOLO_TABLE ] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 25, 24, 23, 22, 21, 20,
+	19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,
+	3, 2, 1, 0,
+};
+//Start of a channel behind the chip struct start
+static const Bit16u ChanOffsetTable[32] = {
+	CHAN_OFFSET( 0 ), CHAN_OFFSET( 2 ), CHAN_OFFSET( 4 ), CHAN_OFFSET( 1 ),
+	CHAN_OFFSET( 3 ), CHAN_OFFSET( 5 ), CHAN_OFFSET( 6 ), CHAN_OFFSET( 7 ),
+	CHAN_OFFSET( 8 ), 0, 0, 0,
+	0, 0, 0, 0,
+	CHAN_OFFSET( 9 ), CHAN_OFFSET( 11 ), CHAN_OFFSET( 13 ), CHAN_OFFSET( 10 ),
+	CHAN_OFFSET( 12 ), CHAN_OFFSET( 14 ), CHAN_OFFSET( 15 ), CHAN_OFFSET( 16 ),
+	CHAN_OFFSET( 17 ), 0, 0, 0,
+	0, 0, 0, 0,
+};
+//Start of an operator behind the chip struct start
+static const Bit16u OpOffsetTable[64] = {
+	OP_OFFSET( 0, 0 ), OP_OFFSET( 2, 0 ), OP_OFFSET( 4, 0 ), OP_OFFSET( 0, 1 ),
+	OP_OFFSET( 2, 1 ), OP_OFFSET( 4, 1 ), 0, 0,
+	OP_OFFSET( 1, 0 ), OP_OFFSET( 3, 0 ), OP_OFFSET( 5, 0 ), OP_OFFSET( 1, 1 ),
+	OP_OFFSET( 3, 1 ), OP_OFFSET( 5, 1 ), 0, 0,
+	OP_OFFSET( 6, 0 ), OP_OFFSET( 7, 0 ), OP_OFFSET( 8, 0 ), OP_OFFSET( 6, 1 ),
+	OP_OFFSET( 7, 1 ), OP_OFFSET( 8, 1 ), 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+	OP_OFFSET( 9, 0 ), OP_OFFSET( 11, 0 ), OP_OFFSET( 13, 0 ), OP_OFFSET( 9, 1 ),
+	OP_OFFSET( 11, 1 ), OP_OFFSET( 13, 1 ), 0, 0,
+	OP_OFFSET( 10, 0 ), OP_OFFSET( 12, 0 ), OP_OFFSET( 14, 0 ), OP_OFFSET( 10, 1 ),
+	OP_OFFSET( 12, 1 ), OP_OFFSET( 14, 1 ), 0, 0,
+	OP_OFFSET( 15, 0 ), OP_OFFSET( 16, 0 ), OP_OFFSET( 17, 0 ), OP_OFFSET( 15, 1 ),
+	OP_OFFSET( 16, 1 ), OP_OFFSET( 17, 1 ), 0, 0,
+	0, 0, 0, 0,
+	0, 0, 0, 0,
+};
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""
+Generates dbopl_tables.h, the lookup tables used by the DOSBox OPL emulator.
+
+The tables used to be filled in by DBOPL::InitTables() the first time a chip
+was set up.  Generating them ahead of time means they are plain constant data,
+so there is nothing to initialise and nothing for threads to race on.  The
+maths is the same as the original C code, and Python's float uses the same
+double precision functions from the C library, so the values are identical.
+
+Run this script again if any of the formulas change.  tests/pyopl_test.py
+checks that the checked in file is up to date.
+"""
+
+import math
+from pathlib import Path
+
+PI = 3.14159265358979323846
+TREMOLO_TABLE = 52
+MUL_SH = 16
+ENV_EXTRA = 0
+
+KSL_CREATE_TABLE = [
+	64, 32, 24, 19,
+	16, 12, 11, 10,
+	8, 6, 5, 4,
+	3, 2, 1, 0,
+]
+
+
+def trunc16s(value: float) -> int:
+	"""Cast a double to Bit16s, rounding towards zero."""
+	return int(value)
+
+
+def as16s(value: int) -> int:
+	"""Reinterpret the low 16 bits as a signed value."""
+	value &= 0xFFFF
+	return value - 0x10000 if value & 0x8000 else value
+
+
+def exp_table() -> list:
+	table = []
+	for i in range(256):
+		# Save them in reverse, preshifted to the left once
+		val = int(0.5 + (math.pow(2.0, (255 - i) * (1.0 / 256)) - 1) * 1024)
+		table.append((val + 1024) * 2)
+	return table
+
+
+def sin_table() -> list:
+	return [
+		trunc16s(0.5 - math.log10(math.sin((i + 0.5) * (PI / 512.0))) / math.log10(2.0) * 256)
+		for i in range(512)
+	]
+
+
+def mul_table() -> list:
+	table = []
+	for i in range(384):
+		s = i * 8
+		val = (0.5 + (math.pow(2.0, -1.0 + (255 - s) * (1.0 / 256))) * (1 << MUL_SH))
+		table.append(int(val))
+	return table
+
+
+def fill_wave_gaps(wave: list) -> None:
+	"""Fill the silence gaps and the replicated parts of a wave table."""
+	for i in range(256):
+		wave[0x400 + i] = wave[0]
+		wave[0x500 + i] = wave[0]
+		wave[0x900 + i] = wave[0]
+		wave[0xc00 + i] = wave[0]
+		wave[0xd00 + i] = wave[0]
+		wave[0x800 + i] = wave[0x200 + i]
+		wave[0xa00 + i] = wave[0x200 + i * 2]
+		wave[0xb00 + i] = wave[0x000 + i * 2]
+		wave[0xe00 + i] = wave[0x200 + i * 2]
+		wave[0xf00 + i] = wave[0x200 + i * 2]
+
+
+def wave_table_mul() -> list:
+	wave = [0] * (8 * 512)
+	# Sine wave base
+	for i in range(512):
+		wave[0x200 + i] = trunc16s(math.sin((i + 0.5) * (PI / 512.0)) * 4084)
+		wave[0x000 + i] = -wave[0x200 + i]
+	# Exponential wave
+	for i in range(256):
+		wave[0x700 + i] = trunc16s(0.5 + (math.pow(2.0, -1.0 + (255 - i * 8) * (1.0 / 256))) * 4085)
+		wave[0x6ff - i] = -wave[0x700 + i]
+	fill_wave_gaps(wave)
+	return wave
+
+
+def wave_table_log() -> list:
+	wave = [0] * (8 * 512)
+	# Sine wave base
+	for i, val in enumerate(sin_table()):
+		wave[0x200 + i] = val
+		wave[0x000 + i] = as16s(0x8000 | val)
+	# Exponential wave
+	for i in range(256):
+		wave[0x700 + i] = i * 8
+		wave[0x6ff - i] = as16s(0x8000 | i * 8)
+	fill_wave_gaps(wave)
+	return wave
+
+
+def ksl_table() -> list:
+	table = []
+	for oct in range(8):
+		base = oct * 8
+		for i in range(16):
+			# *4 for the final range to match attenuation range
+			table.append(max(base - KSL_CREATE_TABLE[i], 0) * 4)
+	return table
+
+
+def tremolo_table() -> list:
+	# Just increase and decrease a triangle wave
+	table = [0] * TREMOLO_TABLE
+	for i in range(TREMOLO_TABLE // 2):
+		table[i] = i << ENV_EXTRA
+		table[TREMOLO_TABLE - 1 - i] = i << ENV_EXTRA
+	return table
+
+
+def chan_offset_table() -> list:
+	table = []
+	for i in range(32):
+		index = i & 0xf
+		if index >= 9:
+			table.append("0")
+			continue
+		# Make sure the four op channels follow eachother
+		if index < 6:
+			index = (index % 3) * 2 + (index // 3)
+		# Add back the bits for highest ones
+		if i >= 16:
+			index += 9
+		table.append("CHAN_OFFSET( %d )" % index)
+	return table
+
+
+def op_offset_table() -> list:
+	chan_offsets = chan_offset_table()
+	table = []
+	for i in range(64):
+		if i % 8 >= 6 or (i // 8) % 4 == 3:
+			table.append("0")
+			continue
+		ch_num = (i // 8) * 3 + (i % 8) % 3
+		# Use 16 and up for the 2nd range to match the chanoffset gap
+		if ch_num >= 12:
+			ch_num += 16 - 12
+		op_num = (i % 8) // 3
+		chan = chan_offsets[ch_num][len("CHAN_OFFSET( "):-len(" )")]
+		table.append("OP_OFFSET( %s, %d )" % (chan, op_num))
+	return table
+
+
+def format_table(decl: str, values: list, per_line: int = 16) -> str:
+	lines = ["static const %s = {" % decl]
+	for start in range(0, len(values), per_line):
+		lines.append("\t" + ", ".join(str(v) for v in values[start:start + per_line]) + ",")
+	lines.append("};")
+	return "\n".join(lines) + "\n"
+
+
+def generate() -> str:
+	"""Return the contents of dbopl_tables.h."""
+	parts = [
+		"//Generated by gen_dbopl_tables.py, do not edit\n",
+		"\n#if ( DBOPL_WAVE == WAVE_HANDLER ) || ( DBOPL_WAVE == WAVE_TABLELOG )\n",
+		format_table("Bit16u ExpTable[ 256 ]", exp_table()),
+		"#endif\n",
+		"\n#if ( DBOPL_WAVE == WAVE_HANDLER )\n",
+		"//PI table used by WAVEHANDLER\n",
+		format_table("Bit16u SinTable[ 512 ]", sin_table()),
+		"#endif\n",
+		"\n#if ( DBOPL_WAVE == WAVE_TABLEMUL )\n",
+		format_table("Bit16s WaveTable[ 8 * 512 ]", wave_table_mul()),
+		"#elif ( DBOPL_WAVE == WAVE_TABLELOG )\n",
+		format_table("Bit16s WaveTable[ 8 * 512 ]", wave_table_log()),
+		"#endif\n",
+		"\n#if ( DBOPL_WAVE == WAVE_TABLEMUL )\n",
+		format_table("Bit16u MulTable[ 384 ]", mul_table()),
+		"//WaveTable widened to 32 bits, so the lane generator can gather from it\n",
+		format_table("Bit32s LaneWaveTable[ 8 * 512 ]", wave_table_mul()),
+		"#endif\n",
+		"\n",
+		format_table("Bit8u KslTable[ 8 * 16 ]", ksl_table()),
+		format_table("Bit8u TremoloTable[ TREMOLO_TABLE ]", tremolo_table()),
+		"//Start of a channel behind the chip struct start\n",
+		format_table("Bit16u ChanOffsetTable[32]", chan_offset_table(), 4),
+		"//Start of an operator behind the chip struct start\n",
+		format_table("Bit16u OpOffsetTable[64]", op_offset_table(), 4),
+	]
+	return "".join(parts)
+
+
+if __name__ == "__main__":
+	Path(__file__).with_name("dbopl_tables.h").write_text(generate())
@@ -19,10 +19,35 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdarg>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "dbopl.h"
 
+// Plain file descriptor access, which Windows names differently
+#ifdef _WIN32
+#include <io.h>
+#define fileWrite(fd, buf, len) _write(fd, buf, (unsigned int)(len))
+#define fileSeek _lseeki64
+#define fileDup _dup
+#define fileClose _close
+#else
+#include <unistd.h>
+#define fileWrite write
+#define fileSeek lseek
+#define fileDup dup
+#define fileClose close
+#endif
+
 #define PyString_FromString PyUnicode_FromString
-#define ERROR_INIT NULL
 
 // Size of each sample in bytes (2 == 16-bit)
 #define SAMPLE_SIZE 2
@@ -36,28 +61,83 @@
 #define SAMP_MIN -((1 << (SAMP_BITS-1)))
 #define CLIP(v) (((v) > SAMP_MAX) ? SAMP_MAX : (((v) < SAMP_MIN) ? SAMP_MIN : (v)))
 
+// Largest number of samples the synth can produce in one go
+#define MAX_SAMPLES 512
+
+// Most chips a single object can emulate
+#define MAX_CHIPS 64
+
+// Fixed point chip panning volumes
+#define PAN_SHIFT 8
+#define PAN_UNITY (1 << PAN_SHIFT)
+
+// Largest preview factor, the chips then run at 1/16 of the output rate
+#define MAX_PREVIEW 16
+
+// Shortest part of a song render() will give its own thread
+#define MIN_SEGMENT_SAMPLES 8192
+
+// Frames of all the chips together each channel group renders before the
+// groups' output is added up, which sets the size of each group's buffer
+#define GROUP_CHUNK_SAMPLES 32768
+
+// Number of samples a sink renders into each of its buffers, before handing
+// it to the writer thread.
+#define SINK_CHUNK_SAMPLES 32768
+
+// Number of samples render_async() renders between checks for cancellation
+#define ASYNC_CHUNK_SAMPLES 8192
+
+// Size of the header at the start of a WAV file written by a sink
+#define WAV_HEADER_SIZE 44
+
+// Number of MAX_SAMPLES sized slots in the stream() ring buffer.  A view
+// returned by stream() stays valid until this many more calls have been made.
+#define RING_SLOTS 4
+
 class SampleHandler: public MixerChannel {
 	public:
-		Py_buffer pybuf;
+		int16_t *out[2];    // Where the first sample of each channel goes
+		Py_ssize_t step[2]; // Distance between samples of each channel, in samples
 		uint8_t channels;
 
-		SampleHandler(uint8_t channels)
+		SampleHandler(uint8_t channels = 1)
 			: channels(channels)
 		{
+			this->setInterleaved(NULL);
 		}
 
 		virtual ~SampleHandler()
 		{
 		}
 
+		// Move past samples that have been written
+		void advance(Bitu samples)
+		{
+			this->out[0] += samples * this->step[0];
+			this->out[1] += samples * this->step[1];
+		}
+
+		// Write both channels to a single buffer of interleaved samples
+		void setInterleaved(int16_t *buf)
+		{
+			this->out[0] = buf;
+			this->out[1] = buf + 1;
+			this->step[0] = this->step[1] = this->channels;
+		}
+
 		virtual void AddSamples_m32(Bitu samples, Bit32s *buffer)
 		{
 			// Convert samples from mono s32 to stereo s16
-			int16_t *out = (int16_t *)this->pybuf.buf;
+			int16_t *left = this->out[0], *right = this->out[1];
 			for (unsigned int i = 0; i < samples; i++) {
 				Bit32s v = buffer[i] << VOL_AMP;
-				*out++ = CLIP(v);
-				if (channels == 2) *out++ = CLIP(v);
+				*left = CLIP(v);
+				left += this->step[0];
+				if (channels == 2) {
+					*right = CLIP(v);
+					right += this->step[1];
+				}
 			}
 			return;
 		}
@@ -65,160 +145,2600 @@ class SampleHandler: public MixerChannel {
 		virtual void AddSamples_s32(Bitu samples, Bit32s *buffer)
 		{
 			// Convert samples from stereo s32 to stereo s16
-			int16_t *out = (int16_t *)this->pybuf.buf;
+			int16_t *left = this->out[0], *right = this->out[1];
 			for (unsigned int i = 0; i < samples; i++) {
 				Bit32s v = buffer[i*2] << VOL_AMP;
-				*out++ = CLIP(v);
+				*left = CLIP(v);
+				left += this->step[0];
 				if (channels == 2) {
 					v = buffer[i*2+1] << VOL_AMP;
-					*out++ = CLIP(v);
+					*right = CLIP(v);
+					right += this->step[1];
 				}
 			}
 			return;
 		}
 };
 
+// Mixes several chips into one 32-bit stereo buffer, panning each chip as it
+// goes, so the final conversion to 16-bit happens only once.
+class ChipMixer: public MixerChannel {
+	public:
+		int64_t sum[MAX_SAMPLES * 2]; // 64 chips at double volume would overflow 32 bits
+		Bit32s buffer[MAX_SAMPLES * 2];
+		Bit32s (*gain)[2]; // Left and right volume of each chip, 256 == unity
+		Bit32s *chipGain;  // Volumes of the chip currently being generated
+		Bit32s *chipBuffer; // Each chip's output before mixing, MAX_SAMPLES * 2 apart
+
+		ChipMixer(int numChips, const ChipMixer *copy = NULL)
+			: gain(new Bit32s[numChips][2]),
+			  chipBuffer(new Bit32s[numChips * MAX_SAMPLES * 2])
+		{
+			for (int i = 0; i < numChips; i++) {
+				this->gain[i][0] = copy ? copy->gain[i][0] : PAN_UNITY;
+				this->gain[i][1] = copy ? copy->gain[i][1] : PAN_UNITY;
+			}
+		}
+
+		virtual ~ChipMixer()
+		{
+			delete[] this->gain;
+			delete[] this->chipBuffer;
+		}
+
+		// Put every chip back in the centre at full volume
+		void reset(int numChips)
+		{
+			for (int i = 0; i < numChips; i++) {
+				this->gain[i][0] = PAN_UNITY;
+				this->gain[i][1] = PAN_UNITY;
+			}
+		}
+
+		void generate(DBOPL::Handler *chips, int numChips, SampleHandler *out, Bitu samples)
+		{
+			// The chips are generated together so their channels can share the SIMD lanes
+			DBOPL::Lanes::Generate(chips, numChips, samples, this->chipBuffer);
+			this->mix(chips, numChips, this->chipBuffer, MAX_SAMPLES * 2, out, samples);
+		}
+
+		// Mix each chip's output, stride apart, which is stereo if the chip is
+		// in OPL3 mode or there are no chips to check.
+		void mix(const DBOPL::Handler *chips, int numChips, Bit32s *chipBuffer, Py_ssize_t stride, SampleHandler *out, Bitu samples)
+		{
+			memset(this->sum, 0, sizeof(int64_t) * samples * 2);
+			for (int i = 0; i < numChips; i++) {
+				this->chipGain = this->gain[i];
+				Bit32s *chipOut = chipBuffer + i * stride;
+				if (!chips || chips[i].chip.opl3Active) {
+					this->AddSamples_s32(samples, chipOut);
+				} else {
+					this->AddSamples_m32(samples, chipOut);
+				}
+			}
+			// Anything this far out clips anyway, so it is limited to where
+			// the output's own clipping can't overflow either
+			const int64_t limit = (int64_t)1 << 24;
+			for (unsigned int i = 0; i < samples * 2; i++) {
+				int64_t v = this->sum[i] >> PAN_SHIFT;
+				this->buffer[i] = (Bit32s)std::max(-limit, std::min(limit, v));
+			}
+			out->AddSamples_s32(samples, this->buffer);
+		}
+
+		virtual void AddSamples_m32(Bitu samples, Bit32s *buffer)
+		{
+			for (unsigned int i = 0; i < samples; i++) {
+				this->sum[i*2] += (int64_t)buffer[i] * this->chipGain[0];
+				this->sum[i*2+1] += (int64_t)buffer[i] * this->chipGain[1];
+			}
+		}
+
+		virtual void AddSamples_s32(Bitu samples, Bit32s *buffer)
+		{
+			for (unsigned int i = 0; i < samples * 2; i += 2) {
+				this->sum[i] += (int64_t)buffer[i] * this->chipGain[0];
+				this->sum[i+1] += (int64_t)buffer[i+1] * this->chipGain[1];
+			}
+		}
+};
+
+// Throws away audio, for when only the chip state matters
+class NullMixer: public MixerChannel {
+	public:
+		virtual void AddSamples_m32(Bitu, Bit32s *)
+		{
+		}
+
+		virtual void AddSamples_s32(Bitu, Bit32s *)
+		{
+		}
+};
+
+// A register write made part way through a render() call
+struct RenderEvent {
+	Py_ssize_t frame; // Sample it happens before
+	unsigned int reg;
+	Bit8u val;
+};
+
+// Everything needed to render part of a song on its own thread
+struct RenderJob {
+	DBOPL::Handler *chips;
+	int numChips;
+	ChipMixer *mixer;  // NULL if the chips don't need mixing
+	SampleHandler *sh; // NULL to only advance the chip state
+	const RenderEvent *ev, *evEnd;
+	Py_ssize_t frame, endFrame;
+};
+
+// Play a list of register writes, generating audio in between.  Writes at or
+// after endFrame are not made.
+static void renderEvents(const RenderJob &job)
+{
+	const RenderEvent *ev = job.ev;
+	Py_ssize_t frame = job.frame;
+	NullMixer discard;
+
+	while (frame < job.endFrame) {
+		for (; (ev < job.evEnd) && (ev->frame <= frame); ev++) {
+			job.chips[ev->reg >> 9].WriteReg(ev->reg & 0x1FF, ev->val);
+		}
+		Py_ssize_t next = job.endFrame;
+		if ((ev < job.evEnd) && (ev->frame < next)) next = ev->frame;
+
+		while (frame < next) {
+			int samples = (int)std::min(next - frame, (Py_ssize_t)MAX_SAMPLES);
+			if (!job.sh) {
+				for (int i = 0; i < job.numChips; i++) job.chips[i].Generate(&discard, samples);
+			} else if (job.mixer) {
+				job.mixer->generate(job.chips, job.numChips, job.sh, samples);
+				job.sh->advance(samples);
+			} else {
+				job.chips->Generate(job.sh, samples);
+				job.sh->advance(samples);
+			}
+			frame += samples;
+		}
+	}
+}
+
+// First frame at or after the given one where renderEvents() starts a new
+// block.  Blocks start at each write and then every MAX_SAMPLES frames, and a
+// channel that is silent at the start of a block skips all of it, so renders
+// split anywhere else wouldn't match.
+static Py_ssize_t blockBoundary(const RenderEvent *ev, const RenderEvent *evEnd, Py_ssize_t frame)
+{
+	const RenderEvent *next = std::upper_bound(ev, evEnd, frame,
+		[](Py_ssize_t frame, const RenderEvent &e) { return frame < e.frame; });
+	Py_ssize_t last = (next > ev) ? next[-1].frame : 0;
+	Py_ssize_t boundary = last + (frame - last + MAX_SAMPLES - 1) / MAX_SAMPLES * MAX_SAMPLES;
+	if ((next < evEnd) && (next->frame < boundary)) boundary = next->frame;
+	return boundary;
+}
+
+// One block of chips for every object in a pool, freed once the pool and all
+// the objects it handed out are gone.
+struct ChipArena {
+	DBOPL::Handler *chips;
+	std::atomic<Py_ssize_t> refs;
+};
+
+static void releaseArena(ChipArena *arena)
+{
+	if (--arena->refs == 0) {
+		delete[] arena->chips;
+		delete arena;
+	}
+}
+
+// Most distinct registers a DRO v2 codemap can hold, leaving two codes for
+// the delays
+#define DRO_MAX_CODES 126
+
+// One register write logged by start_capture()
+struct CaptureWrite {
+	Bit32u delay; // Frames since the previous write
+	Bit16u reg;
+	Bit8u val;
+};
+
+// Register writes made while capturing, timed in output frames so the log is
+// exact whatever the playback rate
+struct Capture {
+	std::vector<CaptureWrite> writes;
+	uint64_t frame;     // Frames generated since the capture started
+	uint64_t lastWrite; // Frame of the last logged write
+	bool active;        // Cleared by stop_capture(), which keeps the log
+
+	void record(unsigned int reg, Bit8u val, uint64_t at)
+	{
+		uint64_t delay = std::min(at - lastWrite, (uint64_t)UINT32_MAX);
+		writes.push_back({(Bit32u)delay, (Bit16u)reg, val});
+		lastWrite = at;
+	}
+};
+
+// Log a write made at the current frame, if capturing
+#define CAPTURE_WRITE(o, reg, val) \
+	if ((o)->capture && (o)->capture->active) (o)->capture->record((reg), (val), (o)->capture->frame)
+
+// Count frames generated while capturing
+#define CAPTURE_FRAMES(o, samples) \
+	if ((o)->capture && (o)->capture->active) (o)->capture->frame += (samples)
+
 struct PyOPL {
 	// Can't put any objects in here (only pointers) as this struct is allocated
 	// with malloc() instead of operator new (so constructors don't get called.)
 	PyObject_HEAD
-	SampleHandler *sh;
-	DBOPL::Handler *opl;
+	uint8_t channels;
+	DBOPL::Handler *opl;  // Array of numChips synths
+	int numChips;
+	unsigned int freq;
+	ChipArena *arena;     // Owner of opl for pooled objects, otherwise NULL
+	int pooled;           // Set while waiting in a pool to be handed out
+	ChipMixer *mixer;     // Only needed for multiple or panned chips
+	int busy;             // Set while render() runs without the GIL
+	int16_t *ring;        // stream() ring buffer, allocated on first use
+	PyObject *ringViews;  // Tuple of read-only memoryviews, one per ring slot
+	int ringFrames;       // Length of each view in ringViews, in samples
+	int ringPos;          // Ring slot the next stream() call will fill
+	Capture *capture;     // Register write log, allocated by start_capture()
 };
 
-PyObject *opl_writeReg(PyObject *self, PyObject *args, PyObject *keywds)
+// Free-threaded builds lock each object for the length of a call, so one
+// object can be shared between threads.  Elsewhere the GIL does the job.
+#ifndef Py_BEGIN_CRITICAL_SECTION
+#define Py_BEGIN_CRITICAL_SECTION(op) {
+#define Py_END_CRITICAL_SECTION() }
+#define Py_BEGIN_CRITICAL_SECTION2(a, b) {
+#define Py_END_CRITICAL_SECTION2() }
+#endif
+
+// Return the result of a call made with the object locked
+#define LOCKED_CALL(self, call) \
+	PyObject *ret; \
+	Py_BEGIN_CRITICAL_SECTION(self); \
+	ret = call; \
+	Py_END_CRITICAL_SECTION(); \
+	return ret
+
+// Refuse to touch an object that render() is using without the GIL (or, on
+// free-threaded builds, without the object's lock)
+#define CHECK_BUSY(o) \
+	if ((o)->busy) { \
+		PyErr_SetString(PyExc_RuntimeError, "opl object is busy rendering"); \
+		return NULL; \
+	}
+
+// The hot methods use METH_FASTCALL, which skips building an argument tuple
+// for every call.  The limited API has no parser for those, so the few
+// argument types they take are converted here.
+
+// Check the number of positional arguments passed to a METH_FASTCALL method
+static int checkArgCount(const char *name, Py_ssize_t nargs, int min, int max)
+{
+	if ((nargs >= min) && (nargs <= max)) return 0;
+	if (min == max) {
+		PyErr_Format(PyExc_TypeError, "%s() takes exactly %d argument%s (%zd given)",
+			name, min, (min == 1) ? "" : "s", nargs);
+	} else {
+		PyErr_Format(PyExc_TypeError, "%s() takes from %d to %d arguments (%zd given)",
+			name, min, max, nargs);
+	}
+	return -1;
+}
+
+// Put positional and keyword arguments into kwlist order, where every
+// argument is required
+static int gatherArgs(const char *name, const char * const *kwlist,
+	PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames, PyObject **out)
+{
+	int count = 0;
+	while (kwlist[count]) count++;
+	if (nargs > count) return checkArgCount(name, nargs, count, count);
+
+	for (int i = 0; i < count; i++) out[i] = (i < nargs) ? args[i] : NULL;
+	Py_ssize_t numKw = kwnames ? PyTuple_Size(kwnames) : 0;
+	for (Py_ssize_t k = 0; k < numKw; k++) {
+		PyObject *key = PyTuple_GetItem(kwnames, k); // borrowed
+		int i = 0;
+		while ((i < count) && (PyUnicode_CompareWithASCIIString(key, kwlist[i]) != 0)) i++;
+		if (i == count) {
+			PyErr_Format(PyExc_TypeError, "%s() got an unexpected keyword argument '%U'", name, key);
+			return -1;
+		}
+		if (out[i]) {
+			PyErr_Format(PyExc_TypeError, "argument for %s() given by name ('%s') and position (%d)",
+				name, kwlist[i], i + 1);
+			return -1;
+		}
+		out[i] = args[nargs + k];
+	}
+	for (int i = 0; i < count; i++) {
+		if (!out[i]) {
+			PyErr_Format(PyExc_TypeError, "%s() missing required argument '%s' (pos %d)",
+				name, kwlist[i], i + 1);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+// Convert an argument to a C int, the same as PyArg_ParseTuple()'s "i"
+static int intArg(PyObject *arg, int *out)
+{
+	long val = PyLong_AsLong(arg);
+	if ((val == -1) && PyErr_Occurred()) return -1;
+	if ((val < INT_MIN) || (val > INT_MAX)) {
+		PyErr_SetString(PyExc_OverflowError, "signed integer is out of range for a C int");
+		return -1;
+	}
+	*out = (int)val;
+	return 0;
+}
+
+// Put the object back the way it was when it was created
+static void opl_resetState(PyOPL *o)
+{
+	for (int i = 0; i < o->numChips; i++) o->opl[i].Init(o->freq);
+	if (o->mixer) o->mixer->reset(o->numChips);
+	o->ringPos = 0;
+	delete o->capture;
+	o->capture = NULL;
+}
+
+static PyObject *opl_reset_impl(PyObject *self, PyObject *Py_UNUSED(ignored))
 {
 	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	opl_resetState(o);
+	Py_RETURN_NONE;
+}
+
+static PyObject *opl_writeReg_impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
 	static const char *kwlist[] = {"reg", "val", NULL};
 
+	// Plain positional calls are by far the most common, so skip the keyword
+	// matching for those
+	PyObject *argv[2] = {NULL, NULL};
+	if (!kwnames && (nargs == 2)) {
+		argv[0] = args[0];
+		argv[1] = args[1];
+	} else if (gatherArgs("writeReg", kwlist, args, nargs, kwnames, argv) < 0) {
+		return NULL;
+	}
 	int reg, val;
-	if (!PyArg_ParseTupleAndKeywords(args, keywds, "ii", (char **)kwlist, &reg, &val)) return NULL;
+	if ((intArg(argv[0], &reg) < 0) || (intArg(argv[1], &val) < 0)) return NULL;
 
-	o->opl->WriteReg(reg, val);
+	// Each chip has a 512 register bank
+	unsigned int chip = (unsigned int)reg >> 9;
+	if (chip >= (unsigned int)o->numChips) {
+		PyErr_SetString(PyExc_ValueError, "register out of range for the number of chips");
+		return NULL;
+	}
+	CAPTURE_WRITE(o, reg, (Bit8u)val);
+	o->opl[chip].WriteReg(reg & 0x1FF, val);
 
 	Py_RETURN_NONE;
 }
 
-PyObject *opl_getSamples(PyObject *self, PyObject *args)
+static PyObject *opl_readReg_impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
 {
 	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
 
-	if (!PyArg_ParseTuple(args, "w*", &o->sh->pybuf)) return NULL;
+	int reg;
+	if (checkArgCount("readReg", nargs, 1, 1) < 0) return NULL;
+	if (intArg(args[0], &reg) < 0) return NULL;
 
-	int samples = o->sh->pybuf.len / SAMPLE_SIZE / o->sh->channels;
-	if (samples > 512) {
-		PyErr_SetString(PyExc_ValueError, "buffer too large (max 512 samples)");
+	unsigned int chip = (unsigned int)reg >> 9;
+	if (chip >= (unsigned int)o->numChips) {
+		PyErr_SetString(PyExc_ValueError, "register out of range for the number of chips");
 		return NULL;
 	}
-	if (samples < 2) {
-		PyErr_SetString(PyExc_ValueError, "buffer too small (min 2 samples)");
-		return NULL;
+	return PyLong_FromLong(o->opl[chip].chip.ReadReg(reg & 0x1FF));
+}
+
+// Generate audio from every chip into the sample handler's buffers
+static void opl_generate(PyOPL *o, SampleHandler *sh, int samples)
+{
+	if (o->mixer) {
+		o->mixer->generate(o->opl, o->numChips, sh, samples);
+	} else {
+		o->opl->Generate(sh, samples);
 	}
+	CAPTURE_FRAMES(o, samples);
+}
+
+static PyObject *opl_setChipPan_impl(PyObject *self, PyObject *args)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
 
-	o->opl->Generate(o->sh, samples);
+	int chip;
+	double left, right;
+	if (!PyArg_ParseTuple(args, "idd", &chip, &left, &right)) return NULL;
+	if ((chip < 0) || (chip >= o->numChips)) {
+		PyErr_SetString(PyExc_ValueError, "invalid chip number");
+		return NULL;
+	}
+	if ((left < 0) || (left > 2) || (right < 0) || (right > 2)) {
+		PyErr_SetString(PyExc_ValueError, "invalid volume (valid values: 0.0 to 2.0)");
+		return NULL;
+	}
 
-	PyBuffer_Release(&o->sh->pybuf); // won't use it any more
+	if (!o->mixer) o->mixer = new ChipMixer(o->numChips);
+	o->mixer->gain[chip][0] = (Bit32s)(left * PAN_UNITY + 0.5);
+	o->mixer->gain[chip][1] = (Bit32s)(right * PAN_UNITY + 0.5);
 
 	Py_RETURN_NONE;
 }
 
-static PyMethodDef opl_methods[] = {
-	{"writeReg",   (PyCFunction)opl_writeReg, METH_VARARGS | METH_KEYWORDS, "writeReg(reg=, val=): Write a value to an OPL register."},
-	{"getSamples", (PyCFunction)opl_getSamples, METH_VARARGS, "getSamples(buffer): Fill the supplied buffer with audio samples."},
-	{NULL, NULL, 0, NULL}
-};
-
-void opl_dealloc(PyObject *self)
+// Check whether a buffer's format describes native 16-bit samples, signed or
+// not as the bits are the same
+static bool isSampleFormat(Py_buffer *pybuf)
 {
-	PyOPL *o = (PyOPL *)self;
-	delete o->opl;
-	delete o->sh;
-	PyObject_Del(self);
-	return;
+	const char *f = pybuf->format;
+	if (pybuf->itemsize != SAMPLE_SIZE) return false;
+	if ((f[0] == '@') || (f[0] == '=')) f++;
+	return ((f[0] == 'h') || (f[0] == 'H')) && (f[1] == '\0');
 }
 
-PyObject *opl_repr(PyObject *self)
+// Point the sample handler at a buffer.  With channel < 0 the buffer receives
+// every channel, either interleaved in one dimension or as a 2D array of
+// shape (samples, channels) in any memory order.  Otherwise it receives only
+// the given channel.  Raw byte buffers must be contiguous, 16-bit sample
+// buffers may have any stride, and any other contiguous one dimensional
+// buffer is taken as raw bytes.  Returns the number of samples the buffer
+// holds, or -1 with an exception set.
+static Py_ssize_t bindBuffer(SampleHandler *sh, Py_buffer *pybuf, int channel)
 {
-	return PyString_FromString("<OPL>");
+	int16_t *buf = (int16_t *)pybuf->buf;
+	Py_ssize_t step, channelStep;
+	Py_ssize_t count; // Samples of any channel in the buffer
+
+	if (pybuf->itemsize == 1) {
+		if (!PyBuffer_IsContiguous(pybuf, 'A')) {
+			PyErr_SetString(PyExc_ValueError, "byte buffers must be contiguous");
+			return -1;
+		}
+		step = 1;
+		count = pybuf->len / SAMPLE_SIZE;
+	} else if (isSampleFormat(pybuf) && (pybuf->ndim >= 1) && (pybuf->ndim <= 2)) {
+		if (pybuf->strides[0] % SAMPLE_SIZE) {
+			PyErr_SetString(PyExc_ValueError, "buffer strides must be a multiple of the sample size");
+			return -1;
+		}
+		step = pybuf->strides[0] / SAMPLE_SIZE;
+		count = pybuf->shape[0];
+	} else if ((pybuf->ndim <= 1) && PyBuffer_IsContiguous(pybuf, 'A')) {
+		step = 1;
+		count = pybuf->len / SAMPLE_SIZE;
+	} else {
+		PyErr_SetString(PyExc_ValueError, "buffer must contain bytes or 16-bit samples, in one dimension or (samples, channels)");
+		return -1;
+	}
+
+	if (pybuf->ndim == 2) {
+		if ((channel >= 0) || (pybuf->shape[1] != sh->channels)) {
+			PyErr_SetString(PyExc_ValueError, "2D buffers must have the shape (samples, channels)");
+			return -1;
+		}
+		if (pybuf->strides[1] % SAMPLE_SIZE) {
+			PyErr_SetString(PyExc_ValueError, "buffer strides must be a multiple of the sample size");
+			return -1;
+		}
+		channelStep = pybuf->strides[1] / SAMPLE_SIZE;
+	} else if (channel < 0) {
+		// Interleaved
+		channelStep = step;
+		step *= sh->channels;
+		count /= sh->channels;
+	} else {
+		// Planar
+		sh->out[channel] = buf;
+		sh->step[channel] = step;
+		return count;
+	}
+	sh->out[0] = buf;
+	sh->out[1] = buf + channelStep;
+	sh->step[0] = sh->step[1] = step;
+	return count;
 }
 
-static PyObject *opl_new(PyTypeObject *type, PyObject *args, PyObject *keywds)
+static PyObject *opl_setChannelMask_impl(PyObject *self, PyObject *args)
 {
-	static const char *kwlist[] = {"freq", "sampleSize", "channels", NULL};
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
 
-	unsigned int freq;
-	uint8_t sampleSize;
-	uint8_t channels;
-	if (!PyArg_ParseTupleAndKeywords(args, keywds, "Ibb", (char **)kwlist, &freq, &sampleSize, &channels)) return NULL;
-	if (sampleSize != SAMPLE_SIZE) {
-		PyErr_SetString(PyExc_ValueError, "invalid sample size (valid values: 2=16-bit)");
+	unsigned int mask;
+	int chip = -1;
+	if (!PyArg_ParseTuple(args, "I|i", &mask, &chip)) return NULL;
+	if (chip >= o->numChips) {
+		PyErr_SetString(PyExc_ValueError, "invalid chip number");
 		return NULL;
 	}
-	if ((channels != 1) && (channels != 2)) {
-		PyErr_SetString(PyExc_ValueError, "invalid channel count (valid values: 1=mono, 2=stereo)");
+
+	for (int i = 0; i < o->numChips; i++) {
+		if ((chip < 0) || (chip == i)) {
+			o->opl[i].chip.channelMask = mask & ((1 << DBOPL::STEM_LANES) - 1);
+		}
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject *opl_getSamples_impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	PyObject *bufObj[2] = {NULL, NULL};
+	Py_buffer pybuf[2];
+	int numBufs = 0;
+	int samples = -1;
+	SampleHandler sh(o->channels);
+
+	if (checkArgCount("getSamples", nargs, 1, 2) < 0) return NULL;
+	bufObj[0] = args[0];
+	if (nargs > 1) bufObj[1] = args[1];
+
+	if (bufObj[1] && (o->channels != 2)) {
+		PyErr_SetString(PyExc_TypeError, "separate channel buffers need a stereo synth");
 		return NULL;
 	}
 
-	// Static ABI doesn't allow calling type->tp_alloc.
-	// Just assume the default allocator is used, and call it directly.
-	PyOPL *o = (PyOPL *)PyType_GenericAlloc(type, 0);
-	if (o) {
-		o->sh = new SampleHandler(channels);
-		o->opl = new DBOPL::Handler();
-		o->opl->Init(freq);
+	for (; (numBufs < 2) && bufObj[numBufs]; numBufs++) {
+		if (PyObject_GetBuffer(bufObj[numBufs], &pybuf[numBufs], PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES) < 0) goto error;
+		// One buffer is interleaved, two buffers are one per channel
+		Py_ssize_t len = bindBuffer(&sh, &pybuf[numBufs], bufObj[1] ? numBufs : -1);
+		if (len < 0) {
+			numBufs++;
+			goto error;
+		}
+		if ((samples >= 0) && (len != samples)) {
+			numBufs++;
+			PyErr_SetString(PyExc_ValueError, "channel buffers must be the same length");
+			goto error;
+		}
+		samples = len;
+	}
+
+	if (samples > MAX_SAMPLES) {
+		PyErr_SetString(PyExc_ValueError, "buffer too large (max 512 samples)");
+		goto error;
+	}
+	if (samples < 2) {
+		PyErr_SetString(PyExc_ValueError, "buffer too small (min 2 samples)");
+		goto error;
 	}
-	return (PyObject *)o;
+
+	opl_generate(o, &sh, samples);
+
+	while (numBufs) PyBuffer_Release(&pybuf[--numBufs]); // won't use them any more
+	Py_RETURN_NONE;
+
+error:
+	while (numBufs) PyBuffer_Release(&pybuf[--numBufs]);
+	return NULL;
 }
 
-static PyType_Slot PyOPLType_spec_slots[] = {
-	{Py_tp_dealloc, (void*)opl_dealloc},
-	{Py_tp_repr, (void*)opl_repr},
-	{Py_tp_doc, (void*)"OPL emulator"},
-	{Py_tp_methods, (void*)opl_methods},
-	{Py_tp_new, (void*)opl_new},
-	{0, NULL},
-};
+// Bind a buffer holding numLanes separate blocks of samples, as either a
+// contiguous buffer of blocks one after the other or an array of shape
+// (lanes, samples, channels).  Points each handler at the start of its block,
+// and returns the number of samples in each block or -1 with an exception set.
+static Py_ssize_t bindLanes(PyOPL *o, Py_buffer *pybuf, SampleHandler *lanes, int numLanes)
+{
+	int16_t *buf = (int16_t *)pybuf->buf;
+	Py_ssize_t samples, laneStep, step, channelStep;
 
-// Must use a dynamic (heap) type in the Static ABI.
-static PyType_Spec PyOPLType_spec = {
-	"pyopl.opl",         // tp_name
-	sizeof(PyOPL),       // tp_basicsize
-	0,                   // tp_itemsize
-	Py_TPFLAGS_DEFAULT,  // tp_flags
-	PyOPLType_spec_slots // slots
-};
+	if ((pybuf->ndim == 3) && isSampleFormat(pybuf)) {
+		// Shape (lanes, samples, channels) in any memory order
+		if ((pybuf->shape[0] != numLanes) || (pybuf->shape[2] != o->channels)) {
+			PyErr_Format(PyExc_ValueError, "3D buffers must have the shape (%d, samples, channels)", numLanes);
+			return -1;
+		}
+		if ((pybuf->strides[0] | pybuf->strides[1] | pybuf->strides[2]) % SAMPLE_SIZE) {
+			PyErr_SetString(PyExc_ValueError, "buffer strides must be a multiple of the sample size");
+			return -1;
+		}
+		samples = pybuf->shape[1];
+		laneStep = pybuf->strides[0] / SAMPLE_SIZE;
+		step = pybuf->strides[1] / SAMPLE_SIZE;
+		channelStep = pybuf->strides[2] / SAMPLE_SIZE;
+	} else if (((pybuf->itemsize == 1) || isSampleFormat(pybuf)) && PyBuffer_IsContiguous(pybuf, 'C')) {
+		// Each lane's interleaved samples one after the other
+		samples = pybuf->len / SAMPLE_SIZE / o->channels / numLanes;
+		laneStep = samples * o->channels;
+		step = o->channels;
+		channelStep = 1;
+	} else {
+		PyErr_SetString(PyExc_ValueError, "buffer must be contiguous, or 16-bit samples of shape (lanes, samples, channels)");
+		return -1;
+	}
 
-static PyMethodDef methods[] = {
-	{NULL, NULL, 0, NULL}
-};
+	if (samples > MAX_SAMPLES) {
+		PyErr_SetString(PyExc_ValueError, "buffer too large (max 512 samples per lane)");
+		return -1;
+	}
+	if (samples < 2) {
+		PyErr_SetString(PyExc_ValueError, "buffer too small (min 2 samples per lane)");
+		return -1;
+	}
 
-static struct PyModuleDef pyoplmodule = {
-	PyModuleDef_HEAD_INIT, // m_base
-	"pyopl",        // m_name
-	NULL,           // m_doc
-	-1,             // m_size
-	methods,        // m_methods
-	NULL,           // m_slots
-	NULL,           // m_traverse
-	NULL,           // m_clear
-	NULL,           // m_free
-};
+	for (int i = 0; i < numLanes; i++) {
+		int16_t *lane = buf + i * laneStep;
+		lanes[i].channels = o->channels;
+		lanes[i].out[0] = lane;
+		lanes[i].out[1] = lane + channelStep;
+		lanes[i].step[0] = lanes[i].step[1] = step;
+	}
+	return samples;
+}
 
-PyMODINIT_FUNC
-PyInit_pyopl(void)
+static PyObject *opl_getStems_impl(PyObject *self, PyObject *args)
 {
-	PyObject *module;
-	module = PyModule_Create(&pyoplmodule);
-	if (!module) return ERROR_INIT;
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	PyObject *bufObj;
+	Py_buffer pybuf;
+	int numLanes = DBOPL::STEM_LANES * o->numChips;
+	std::vector<SampleHandler> lanes(numLanes);
+	MixerChannel *chans[DBOPL::STEM_LANES];
 
-	static PyObject *PyOPLType = PyType_FromSpec(&PyOPLType_spec);
+	if (!PyArg_ParseTuple(args, "O", &bufObj)) return NULL;
+	if (PyObject_GetBuffer(bufObj, &pybuf, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES) < 0) return NULL;
 
-	Py_INCREF(PyOPLType);
-	if (PyModule_AddObject(module, "opl", PyOPLType) < 0)
-	{
-		Py_DECREF(PyOPLType);
-		Py_DECREF(module);
-		return ERROR_INIT;
+	Py_ssize_t samples = bindLanes(o, &pybuf, lanes.data(), numLanes);
+	if (samples < 0) {
+		PyBuffer_Release(&pybuf);
+		return NULL;
+	}
+
+	// Each chip's lanes follow the previous chip's
+	for (int chip = 0; chip < o->numChips; chip++) {
+		for (int i = 0; i < DBOPL::STEM_LANES; i++) {
+			chans[i] = &lanes[chip * DBOPL::STEM_LANES + i];
+		}
+		o->opl[chip].GenerateStems(chans, samples);
+	}
+	CAPTURE_FRAMES(o, samples);
+
+	PyBuffer_Release(&pybuf);
+	Py_RETURN_NONE;
+}
+
+static PyObject *opl_getChipSamples_impl(PyObject *self, PyObject *args)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	PyObject *bufObj;
+	Py_buffer pybuf;
+	std::vector<SampleHandler> lanes(o->numChips);
+
+	if (!PyArg_ParseTuple(args, "O", &bufObj)) return NULL;
+	if (PyObject_GetBuffer(bufObj, &pybuf, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES) < 0) return NULL;
+
+	Py_ssize_t samples = bindLanes(o, &pybuf, lanes.data(), o->numChips);
+	if (samples < 0) {
+		PyBuffer_Release(&pybuf);
+		return NULL;
+	}
+
+	if (!o->mixer) {
+		o->opl->Generate(&lanes[0], samples);
+	} else {
+		// Generated together so the chips' channels share the SIMD lanes,
+		// then converted one chip at a time without any panning
+		Bit32s *chipBuffer = o->mixer->chipBuffer;
+		DBOPL::Lanes::Generate(o->opl, o->numChips, samples, chipBuffer);
+		for (int i = 0; i < o->numChips; i++) {
+			Bit32s *chipOut = chipBuffer + i * MAX_SAMPLES * 2;
+			if (o->opl[i].chip.opl3Active) {
+				lanes[i].AddSamples_s32(samples, chipOut);
+			} else {
+				lanes[i].AddSamples_m32(samples, chipOut);
+			}
+		}
+	}
+	CAPTURE_FRAMES(o, samples);
+
+	PyBuffer_Release(&pybuf);
+	Py_RETURN_NONE;
+}
+
+// Render a song in one piece, or split into segments rendered on their own
+// threads.  In the latter case one pass over the song advances the chips
+// without producing any audio, which is cheap, and snapshots them at the
+// start of each segment so a worker can render it from there.
+static void opl_renderSegments(PyOPL *o, SampleHandler *sh, const RenderEvent *ev,
+	const RenderEvent *evEnd, Py_ssize_t total, int threads)
+{
+	RenderJob job = {o->opl, o->numChips, o->mixer, sh, ev, evEnd, 0, total};
+	if (threads <= 1) {
+		renderEvents(job);
+		return;
 	}
-	return module;
+
+	std::vector<RenderJob> jobs(threads, job);
+	std::vector<SampleHandler> handlers(threads, *sh);
+	std::vector<ChipMixer *> mixers(threads, (ChipMixer *)NULL);
+	std::vector<std::thread> workers;
+	DBOPL::Handler *snapshots = new DBOPL::Handler[threads * o->numChips];
+	std::vector<Bit32u> masks(o->numChips);
+	for (int i = 0; i < o->numChips; i++) masks[i] = o->opl[i].chip.channelMask;
+
+	for (int seg = 0; seg < threads; seg++) {
+		RenderJob &segJob = jobs[seg];
+		// Segments start where a single-threaded render would start a block
+		segJob.frame = std::min(total, blockBoundary(ev, evEnd, total * seg / threads));
+		segJob.endFrame = std::min(total, blockBoundary(ev, evEnd, total * (seg + 1) / threads));
+		segJob.ev = std::lower_bound(ev, evEnd, segJob.frame,
+			[](const RenderEvent &e, Py_ssize_t frame) { return e.frame < frame; });
+		segJob.evEnd = evEnd;
+
+		// Start the segment from the chips' current state
+		segJob.chips = snapshots + seg * o->numChips;
+		for (int i = 0; i < o->numChips; i++) {
+			segJob.chips[i].CopyState(o->opl[i]);
+			segJob.chips[i].chip.channelMask = masks[i];
+		}
+		if (o->mixer) segJob.mixer = mixers[seg] = new ChipMixer(o->numChips, o->mixer);
+		handlers[seg].advance(segJob.frame);
+		segJob.sh = &handlers[seg];
+		workers.push_back(std::thread(renderEvents, segJob));
+		if (seg == threads - 1) break;
+
+		// Silently bring the chips up to the start of the next segment
+		RenderJob skip = segJob;
+		skip.chips = o->opl;
+		skip.mixer = NULL;
+		skip.sh = NULL;
+		for (int i = 0; i < o->numChips; i++) o->opl[i].chip.channelMask = 0;
+		renderEvents(skip);
+	}
+	for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+	// The last segment finished where the song did
+	for (int i = 0; i < o->numChips; i++) o->opl[i].CopyState(jobs[threads - 1].chips[i]);
+	for (size_t i = 0; i < mixers.size(); i++) delete mixers[i];
+	delete[] snapshots;
+}
+
+// One group of channels' share of a render() split by channel
+struct GroupJob {
+	DBOPL::Handler *chips; // Copies of the chips that only generate the group
+	int numChips;
+	Bit32u mask;           // Channels in the group
+	const RenderEvent *ev, *evEnd;
+	Py_ssize_t frame, stride;
+	Bit32s *out;           // Each chip's stereo output, stride apart
+};
+
+// Render the group's channels up to endFrame, making every register write on
+// the way.  Mono chips are widened to stereo so the groups can be added up
+// without caring which mode each chip was in.
+static void renderGroup(GroupJob *job, Py_ssize_t endFrame)
+{
+	Py_ssize_t start = job->frame;
+
+	while (job->frame < endFrame) {
+		for (; (job->ev < job->evEnd) && (job->ev->frame <= job->frame); job->ev++) {
+			job->chips[job->ev->reg >> 9].WriteReg(job->ev->reg & 0x1FF, job->ev->val);
+		}
+		Py_ssize_t next = endFrame;
+		if ((job->ev < job->evEnd) && (job->ev->frame < next)) next = job->ev->frame;
+
+		while (job->frame < next) {
+			int samples = (int)std::min(next - job->frame, (Py_ssize_t)MAX_SAMPLES);
+			Py_ssize_t offset = (job->frame - start) * 2;
+			DBOPL::Lanes *queue = DBOPL::Lanes::Get();
+			for (int i = 0; i < job->numChips; i++) {
+				job->chips[i].GenerateOutput(job->out + i * job->stride + offset, samples, 1, queue);
+			}
+			if (queue) queue->Flush();
+			for (int i = 0; i < job->numChips; i++) {
+				if (job->chips[i].chip.opl3Active) continue;
+				Bit32s *out = job->out + i * job->stride + offset;
+				for (int j = samples - 1; j >= 0; j--) out[j * 2] = out[j * 2 + 1] = out[j];
+			}
+			job->frame += samples;
+		}
+	}
+}
+
+// Render a song with the channels of each chip split into groups, each on its
+// own thread with its own copy of the chips.  The channels only share the LFO
+// and noise generator, which every copy runs for itself, so adding up the
+// groups' output gives exactly what a single-threaded render would.
+static void opl_renderGroups(PyOPL *o, SampleHandler *sh, const RenderEvent *ev,
+	const RenderEvent *evEnd, Py_ssize_t total, int groups)
+{
+	// 4-op pairs only have to stay together if 4-op mode can be turned on
+	bool fourOp = false;
+	for (int i = 0; i < o->numChips; i++) {
+		if (o->opl[i].chip.reg104 & 0x3F) fourOp = true;
+	}
+	for (const RenderEvent *e = ev; e < evEnd; e++) {
+		if (((e->reg & 0x1FF) == 0x104) && (e->val & 0x3F)) fourOp = true;
+	}
+
+	// Fewer frames at a time with more chips, so the buffers stay a sensible
+	// size.  Each chunk runs on to the end of a block, as the render would
+	// come out differently if a block was split.
+	Py_ssize_t chunk = std::max((Py_ssize_t)MAX_SAMPLES, (Py_ssize_t)(GROUP_CHUNK_SAMPLES / o->numChips));
+	Py_ssize_t stride = (chunk + MAX_SAMPLES) * 2;
+	std::vector<GroupJob> jobs;
+	std::vector<Bit32u> masks(o->numChips);
+	for (int i = 0; i < o->numChips; i++) masks[i] = o->opl[i].chip.groupMask;
+	for (int group = 0; group < groups; group++) {
+		GroupJob job = {NULL, o->numChips, DBOPL::Handler::GroupMask(group, groups, fourOp), ev, evEnd, 0, stride, NULL};
+		if (!job.mask) break;
+		job.chips = new DBOPL::Handler[o->numChips];
+		job.out = new Bit32s[o->numChips * stride];
+		for (int i = 0; i < o->numChips; i++) {
+			job.chips[i].CopyState(o->opl[i]);
+			job.chips[i].chip.groupMask = job.mask;
+		}
+		jobs.push_back(job);
+	}
+
+	Bit32s *sum = jobs[0].out;
+	for (Py_ssize_t frame = 0; frame < total; ) {
+		Py_ssize_t endFrame = std::min(total, blockBoundary(ev, evEnd, frame + chunk));
+		std::vector<std::thread> workers;
+		for (size_t group = 1; group < jobs.size(); group++) {
+			workers.push_back(std::thread(renderGroup, &jobs[group], endFrame));
+		}
+		renderGroup(&jobs[0], endFrame);
+		for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+		for (size_t group = 1; group < jobs.size(); group++) {
+			for (int i = 0; i < o->numChips; i++) {
+				Bit32s *in = jobs[group].out + i * stride, *out = sum + i * stride;
+				for (Py_ssize_t j = 0; j < (endFrame - frame) * 2; j++) out[j] += in[j];
+			}
+		}
+		for (Py_ssize_t pos = 0; pos < endFrame - frame; pos += MAX_SAMPLES) {
+			int samples = (int)std::min(endFrame - frame - pos, (Py_ssize_t)MAX_SAMPLES);
+			if (o->mixer) {
+				o->mixer->mix(NULL, o->numChips, sum + pos * 2, stride, sh, samples);
+			} else {
+				sh->AddSamples_s32(samples, sum + pos * 2);
+			}
+			sh->advance(samples);
+		}
+		frame = endFrame;
+	}
+
+	// Group 0 has the percussion channels, so its copies also have the noise
+	// generator's state, and the other groups fill in their channels
+	for (int i = 0; i < o->numChips; i++) {
+		o->opl[i].CopyState(jobs[0].chips[i]);
+		o->opl[i].chip.groupMask = masks[i];
+		for (size_t group = 1; group < jobs.size(); group++) {
+			o->opl[i].MergeGroup(jobs[group].chips[i], jobs[group].mask);
+		}
+	}
+	for (size_t group = 0; group < jobs.size(); group++) {
+		delete[] jobs[group].chips;
+		delete[] jobs[group].out;
+	}
+}
+
+// Get a writable view of a render() buffer.  Objects that aren't buffers but
+// hold one in a `buf` attribute, like a multiprocessing SharedMemory, are
+// used through that, which leaves no view of it behind to stop it closing.
+static int getRenderBuffer(PyObject *obj, Py_buffer *pybuf)
+{
+	int flags = PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES;
+	if (!PyObject_CheckBuffer(obj)) {
+		PyObject *buf = PyObject_GetAttrString(obj, "buf");
+		if (buf) {
+			int ret = PyObject_GetBuffer(buf, pybuf, flags);
+			Py_DECREF(buf);
+			return ret;
+		}
+		PyErr_Clear();
+	}
+	return PyObject_GetBuffer(obj, pybuf, flags);
+}
+
+// Read (frame, reg, val) tuples for a render of `total` frames, logging them
+// if capturing.  Returns -1 with an exception set if any are invalid.
+static int collectEvents(PyOPL *o, PyObject *events, Py_ssize_t total, std::vector<RenderEvent> *list)
+{
+	PyObject *iter = PyObject_GetIter(events), *item;
+	if (!iter) return -1;
+	while ((item = PyIter_Next(iter))) {
+		RenderEvent e;
+		int ok = PyArg_ParseTuple(item, "nIb", &e.frame, &e.reg, &e.val);
+		Py_DECREF(item);
+		if (!ok) break;
+		if ((e.frame < (list->empty() ? 0 : list->back().frame)) || (e.frame > total)) {
+			PyErr_SetString(PyExc_ValueError, "event frames must be in order and within the buffer");
+			break;
+		}
+		if ((e.reg >> 9) >= (unsigned int)o->numChips) {
+			PyErr_SetString(PyExc_ValueError, "register out of range for the number of chips");
+			break;
+		}
+		list->push_back(e);
+	}
+	Py_DECREF(iter);
+	if (PyErr_Occurred()) return -1;
+	return 0;
+}
+
+// Log the writes of a render that covered `frames` samples, with each write
+// timed from the start of the buffer
+static void captureEvents(PyOPL *o, const RenderEvent *ev, const RenderEvent *evEnd, Py_ssize_t frames)
+{
+	if (!o->capture || !o->capture->active) return;
+	for (; ev < evEnd; ev++) o->capture->record(ev->reg, ev->val, o->capture->frame + ev->frame);
+	o->capture->frame += frames;
+}
+
+// Make the writes at the very end of a render, which take effect for the next call
+static void applyEndWrites(PyOPL *o, const RenderEvent *ev, const RenderEvent *evEnd, Py_ssize_t total)
+{
+	for (ev = std::lower_bound(ev, evEnd, total,
+		[](const RenderEvent &e, Py_ssize_t frame) { return e.frame < frame; }); ev < evEnd; ev++) {
+		o->opl[ev->reg >> 9].WriteReg(ev->reg & 0x1FF, ev->val);
+	}
+}
+
+// Render one piece of a longer list of writes, from `frame` up to but not
+// including `endFrame`, leaving sh just past it.  Pieces must start on block boundaries for the
+// output to match a single render.
+static void renderRange(PyOPL *o, SampleHandler *sh, const RenderEvent *ev, const RenderEvent *evEnd,
+	Py_ssize_t frame, Py_ssize_t endFrame)
+{
+	RenderJob job = {o->opl, o->numChips, o->mixer, sh,
+		std::lower_bound(ev, evEnd, frame,
+			[](const RenderEvent &e, Py_ssize_t frame) { return e.frame < frame; }),
+		evEnd, frame, endFrame};
+	renderEvents(job);
+}
+
+static PyObject *opl_render_impl(PyObject *self, PyObject *args, PyObject *keywds)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	static const char *kwlist[] = {"events", "buffer", "threads", "groups", "offset", "frames", NULL};
+
+	PyObject *events, *bufObj;
+	Py_buffer pybuf;
+	int threads = 1, groups = 1;
+	Py_ssize_t offset = 0, frames = -1;
+	std::vector<RenderEvent> list;
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|iinn", (char **)kwlist, &events, &bufObj, &threads, &groups, &offset, &frames)) return NULL;
+	if (threads < 1) {
+		PyErr_SetString(PyExc_ValueError, "invalid thread count (min 1)");
+		return NULL;
+	}
+	if (groups < 1) {
+		PyErr_SetString(PyExc_ValueError, "invalid group count (min 1)");
+		return NULL;
+	}
+	if ((threads > 1) && (groups > 1)) {
+		PyErr_SetString(PyExc_ValueError, "threads and groups can't both be used");
+		return NULL;
+	}
+
+	// Getting the buffer and the events can run Python code, which may let
+	// another thread in, so mark the object as in use from here on.
+	o->busy = 1;
+	if (getRenderBuffer(bufObj, &pybuf) < 0) {
+		o->busy = 0;
+		return NULL;
+	}
+	SampleHandler sh(o->channels);
+	Py_ssize_t total = bindBuffer(&sh, &pybuf, -1);
+	if (total < 0) goto error;
+
+	// Rendering into part of the buffer means a shared one can be used
+	// without slicing it
+	if ((offset < 0) || (offset > total) || (frames > total - offset)) {
+		PyErr_SetString(PyExc_ValueError, "offset and frames must be within the buffer");
+		goto error;
+	}
+	sh.advance(offset);
+	total = (frames < 0) ? total - offset : frames;
+
+	// Collect the events first, so rendering doesn't need the GIL
+	if (collectEvents(o, events, total, &list) < 0) goto error;
+	captureEvents(o, list.data(), list.data() + list.size(), total);
+
+	// Threads only pay off for reasonably long segments
+	threads = (int)std::max((Py_ssize_t)1, std::min((Py_ssize_t)threads, total / MIN_SEGMENT_SAMPLES));
+	if (total < MIN_SEGMENT_SAMPLES) groups = 1;
+	// Muted catch up runs leave nothing to interpolate from in preview mode,
+	// and the interpolation needs all the channels at once
+	if (o->opl[0].previewShift) threads = groups = 1;
+
+	Py_BEGIN_ALLOW_THREADS
+	const RenderEvent *ev = list.data(), *evEnd = ev + list.size();
+	if (groups > 1) {
+		opl_renderGroups(o, &sh, ev, evEnd, total, groups);
+	} else {
+		opl_renderSegments(o, &sh, ev, evEnd, total, threads);
+	}
+	applyEndWrites(o, ev, evEnd, total);
+	Py_END_ALLOW_THREADS
+	o->busy = 0;
+
+	PyBuffer_Release(&pybuf);
+	Py_RETURN_NONE;
+
+error:
+	o->busy = 0;
+	PyBuffer_Release(&pybuf);
+	return NULL;
+}
+
+// Call a function in a module
+static PyObject *callModule(const char *module, const char *func, const char *format, ...)
+{
+	PyObject *mod = PyImport_ImportModule(module);
+	if (!mod) return NULL;
+	PyObject *f = PyObject_GetAttrString(mod, func);
+	Py_DECREF(mod);
+	if (!f) return NULL;
+	va_list va;
+	va_start(va, format);
+	PyObject *args = Py_VaBuildValue(format, va);
+	va_end(va);
+	PyObject *ret = args ? PyObject_CallObject(f, args) : NULL;
+	Py_XDECREF(args);
+	Py_DECREF(f);
+	return ret;
+}
+
+// A render_async() call, shared by the worker rendering it and the callbacks
+// that cancel and finish it on the event loop's thread
+struct AsyncJob {
+	PyInterpreterState *interp = NULL;
+	PyObject *synth = NULL;  // These are only touched with the GIL held, and
+	PyObject *loop = NULL;   // are released once the job has finished
+	PyObject *future = NULL;
+	Py_buffer pybuf;
+	SampleHandler sh;
+	std::vector<RenderEvent> events;
+	Py_ssize_t total = 0;
+	Py_ssize_t rendered = 0; // Set by the worker before it hands the job back
+	std::atomic<bool> cancelled{false};
+};
+
+// Threads that run one interpreter's render_async() calls.  They are started
+// on first use and stopped before the interpreter goes away, as they attach
+// to it to hand each job back.
+struct AsyncPool {
+	std::mutex lock;
+	std::condition_variable cond;
+	std::vector<std::shared_ptr<AsyncJob>> queue;
+	size_t head = 0;      // Next job in queue to start
+	std::vector<std::shared_ptr<AsyncJob>> orphans; // Jobs left for async_shutdown() to finish
+	std::vector<std::thread> threads;
+	std::atomic<bool> stop{false};
+};
+
+// Per-interpreter module state, so the module can be loaded into isolated
+// subinterpreters.
+struct ModuleState {
+	PyObject *oplType;
+	PyObject *poolType;
+	PyObject *sinkType;
+	AsyncPool *asyncPool; // NULL until render_async() is first used
+};
+
+#if PY_VERSION_HEX >= 0x03090000
+static ModuleState *typeState(PyTypeObject *type)
+{
+	return (ModuleState *)PyType_GetModuleState(type);
+}
+#else
+// Types can't find the module that created them before 3.9, so use the state
+// of the module loaded last.
+static ModuleState *lastState;
+static ModuleState *typeState(PyTypeObject *)
+{
+	return lastState;
+}
+#endif
+
+// Release everything the job holds and mark the object as free again, then
+// set the future's result if `notify` is set.  A cancelled job's future is
+// left alone, and so are the writes at the end of the buffer as the render
+// stopped short of them.  Only what was actually rendered is captured.
+static void async_finish(AsyncJob *job, bool notify)
+{
+	PyOPL *o = (PyOPL *)job->synth;
+	if (!o) return;
+	bool cancelled = job->cancelled;
+	const RenderEvent *ev = job->events.data(), *evEnd = ev + job->events.size();
+	Py_BEGIN_CRITICAL_SECTION(job->synth);
+	if (cancelled) {
+		evEnd = std::lower_bound(ev, evEnd, job->rendered,
+			[](const RenderEvent &e, Py_ssize_t frame) { return e.frame < frame; });
+		captureEvents(o, ev, evEnd, job->rendered);
+	} else {
+		applyEndWrites(o, ev, evEnd, job->total);
+		captureEvents(o, ev, evEnd, job->total);
+	}
+	o->busy = 0;
+	Py_END_CRITICAL_SECTION();
+	PyBuffer_Release(&job->pybuf);
+
+	// The future may have been cancelled since the worker finished, before
+	// its callback had a chance to say so
+	if (notify && !cancelled) {
+		PyObject *ret = PyObject_CallMethod(job->future, "done", NULL);
+		int done = ret ? PyObject_IsTrue(ret) : -1;
+		Py_XDECREF(ret);
+		if (done == 0) {
+			ret = PyObject_CallMethod(job->future, "set_result", "O", Py_None);
+			Py_XDECREF(ret);
+			if (!ret) done = -1;
+		}
+		if (done < 0) PyErr_WriteUnraisable(job->future);
+	}
+
+	Py_CLEAR(job->synth);
+	Py_CLEAR(job->loop);
+	Py_CLEAR(job->future);
+}
+
+static void async_freeCapsule(PyObject *capsule)
+{
+	delete (std::shared_ptr<AsyncJob> *)PyCapsule_GetPointer(capsule, "pyopl.AsyncJob");
+}
+
+// Wrap a job so a callback can be bound to it
+static PyObject *async_capsule(const std::shared_ptr<AsyncJob> &job)
+{
+	auto *ref = new std::shared_ptr<AsyncJob>(job);
+	PyObject *capsule = PyCapsule_New(ref, "pyopl.AsyncJob", async_freeCapsule);
+	if (!capsule) delete ref;
+	return capsule;
+}
+
+static AsyncJob *async_job(PyObject *capsule)
+{
+	return ((std::shared_ptr<AsyncJob> *)PyCapsule_GetPointer(capsule, "pyopl.AsyncJob"))->get();
+}
+
+// Called on the event loop once the worker is done
+static PyObject *async_done(PyObject *capsule, PyObject *Py_UNUSED(ignored))
+{
+	async_finish(async_job(capsule), true);
+	Py_RETURN_NONE;
+}
+
+// Added to the future, so cancelling it stops the render at the next chunk.
+// It runs when the future is finished normally too, by which time the render
+// is over.
+static PyObject *async_cancel(PyObject *capsule, PyObject *Py_UNUSED(future))
+{
+	async_job(capsule)->cancelled = true;
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef asyncDoneDef = {"_render_done", (PyCFunction)async_done, METH_NOARGS, NULL};
+static PyMethodDef asyncCancelDef = {"_render_cancel", (PyCFunction)async_cancel, METH_O, NULL};
+
+static void async_worker(AsyncPool *pool)
+{
+	for (;;) {
+		std::shared_ptr<AsyncJob> job;
+		{
+			std::unique_lock<std::mutex> l(pool->lock);
+			pool->cond.wait(l, [pool] { return pool->stop || (pool->head < pool->queue.size()); });
+			if (pool->stop) return;
+			job = std::move(pool->queue[pool->head++]);
+			if (pool->head == pool->queue.size()) {
+				pool->queue.clear();
+				pool->head = 0;
+			}
+		}
+
+		// Rendered in chunks starting on the same block boundaries as a
+		// single render() call, checking for cancellation in between
+		PyOPL *o = (PyOPL *)job->synth;
+		const RenderEvent *ev = job->events.data(), *evEnd = ev + job->events.size();
+		Py_ssize_t frame = 0;
+		while ((frame < job->total) && !job->cancelled && !pool->stop) {
+			Py_ssize_t endFrame = std::min(job->total, blockBoundary(ev, evEnd, frame + ASYNC_CHUNK_SAMPLES));
+			renderRange(o, &job->sh, ev, evEnd, frame, endFrame);
+			frame = endFrame;
+		}
+		job->rendered = frame;
+
+		// Once the pool is stopping the interpreter may not be attached to,
+		// so whoever is stopping it finishes the job instead
+		{
+			std::lock_guard<std::mutex> l(pool->lock);
+			if (pool->stop) {
+				pool->orphans.push_back(std::move(job));
+				return;
+			}
+		}
+
+		// The future has to be finished on the loop's own thread, so this
+		// thread only needs the interpreter long enough to schedule that
+		PyThreadState *ts = PyThreadState_New(job->interp);
+		PyEval_RestoreThread(ts);
+		PyObject *capsule = async_capsule(job);
+		PyObject *done = capsule ? PyCFunction_New(&asyncDoneDef, capsule) : NULL;
+		Py_XDECREF(capsule);
+		PyObject *ret = done ? PyObject_CallMethod(job->loop, "call_soon_threadsafe", "O", done) : NULL;
+		Py_XDECREF(done);
+		if (!ret) {
+			// The loop has been closed, so there is nobody left to tell
+			PyErr_Clear();
+			async_finish(job.get(), false);
+		}
+		Py_XDECREF(ret);
+		job.reset();
+		PyThreadState_Clear(ts);
+		PyEval_SaveThread();
+		PyThreadState_Delete(ts);
+	}
+}
+
+static std::mutex asyncPoolLock; // Guards starting each state's pool
+
+// Queue a job on the interpreter's pool, starting it if need be.  Fails once
+// the pool has been stopped.
+static int async_submit(ModuleState *state, const std::shared_ptr<AsyncJob> &job)
+{
+	AsyncPool *pool;
+	{
+		std::lock_guard<std::mutex> l(asyncPoolLock);
+		if (!state->asyncPool) {
+			pool = new AsyncPool();
+			unsigned int count = std::max(1u, std::thread::hardware_concurrency());
+			for (unsigned int i = 0; i < count; i++) pool->threads.emplace_back(async_worker, pool);
+			state->asyncPool = pool;
+		}
+		pool = state->asyncPool;
+	}
+	bool stopped;
+	{
+		std::lock_guard<std::mutex> l(pool->lock);
+		stopped = pool->stop;
+		if (!stopped) pool->queue.push_back(job);
+	}
+	if (stopped) {
+		PyErr_SetString(PyExc_RuntimeError, "render_async() can't be used while the interpreter is shutting down");
+		return -1;
+	}
+	pool->cond.notify_one();
+	return 0;
+}
+
+// Stop the interpreter's workers, with the GIL held.  Renders in progress are
+// cut short, and every job not handed back to its loop is finished here
+// without touching its future, as the loop won't run again.  Called at exit,
+// while the workers can still take the GIL, and again when the module is
+// freed.
+static void async_shutdown(ModuleState *state)
+{
+	AsyncPool *pool = state->asyncPool;
+	if (!pool) return;
+	{
+		std::lock_guard<std::mutex> l(pool->lock);
+		pool->stop = true;
+		for (size_t i = pool->head; i < pool->queue.size(); i++) pool->orphans.push_back(std::move(pool->queue[i]));
+		pool->queue.clear();
+		pool->head = 0;
+	}
+	pool->cond.notify_all();
+
+	// A worker may be waiting for the GIL to hand a job back
+	if (!pool->threads.empty()) {
+		Py_BEGIN_ALLOW_THREADS
+		for (std::thread &t : pool->threads) t.join();
+		Py_END_ALLOW_THREADS
+		pool->threads.clear();
+	}
+
+	for (std::shared_ptr<AsyncJob> &job : pool->orphans) {
+		job->cancelled = true;
+		async_finish(job.get(), false);
+	}
+	pool->orphans.clear();
+}
+
+static PyObject *opl_renderAsync_impl(PyObject *self, PyObject *args, PyObject *keywds)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	static const char *kwlist[] = {"events", "buffer", "offset", "frames", NULL};
+
+	PyObject *events, *bufObj;
+	Py_ssize_t offset = 0, frames = -1;
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|nn", (char **)kwlist, &events, &bufObj, &offset, &frames)) return NULL;
+
+	PyObject *loop = callModule("asyncio", "get_running_loop", "()");
+	if (!loop) return NULL;
+	PyObject *future = PyObject_CallMethod(loop, "create_future", NULL);
+	if (!future) {
+		Py_DECREF(loop);
+		return NULL;
+	}
+
+	auto job = std::make_shared<AsyncJob>();
+	job->interp = PyInterpreterState_Get();
+	job->sh.channels = o->channels;
+	job->loop = loop;
+	job->future = future;
+
+	// As for render(), from here on nothing else may use the object
+	o->busy = 1;
+	if (getRenderBuffer(bufObj, &job->pybuf) < 0) {
+		o->busy = 0;
+		Py_DECREF(loop);
+		Py_DECREF(future);
+		return NULL;
+	}
+	Py_INCREF(self);
+	job->synth = self;
+
+	PyObject *capsule, *cancel, *ret;
+	job->total = bindBuffer(&job->sh, &job->pybuf, -1);
+	if (job->total < 0) goto error;
+	if ((offset < 0) || (offset > job->total) || (frames > job->total - offset)) {
+		PyErr_SetString(PyExc_ValueError, "offset and frames must be within the buffer");
+		goto error;
+	}
+	job->sh.advance(offset);
+	job->total = (frames < 0) ? job->total - offset : frames;
+	if (collectEvents(o, events, job->total, &job->events) < 0) goto error;
+
+	capsule = async_capsule(job);
+	cancel = capsule ? PyCFunction_New(&asyncCancelDef, capsule) : NULL;
+	Py_XDECREF(capsule);
+	ret = cancel ? PyObject_CallMethod(future, "add_done_callback", "O", cancel) : NULL;
+	Py_XDECREF(cancel);
+	if (!ret) goto error;
+	Py_DECREF(ret);
+
+	if (async_submit(typeState(Py_TYPE(self)), job) < 0) goto error;
+	Py_INCREF(future);
+	return future;
+
+error:
+	// Nothing has been rendered, so none of the writes are made either
+	job->cancelled = true;
+	async_finish(job.get(), false);
+	return NULL;
+}
+
+// Create one memoryview per ring slot, each covering the first `frames`
+// samples of that slot.  The views are slices of a single export of the
+// ring, so the buffer protocol keeps this object alive while any are in use.
+static PyObject *opl_makeRingViews(PyOPL *o, int frames)
+{
+	PyObject *ring = PyMemoryView_FromObject((PyObject *)o);
+	if (!ring) return NULL;
+
+	PyObject *views = PyTuple_New(RING_SLOTS);
+	if (!views) {
+		Py_DECREF(ring);
+		return NULL;
+	}
+	Py_ssize_t slotLen = MAX_SAMPLES * o->channels * SAMPLE_SIZE;
+	Py_ssize_t viewLen = frames * o->channels * SAMPLE_SIZE;
+	for (int i = 0; i < RING_SLOTS; i++) {
+		PyObject *start = PyLong_FromSsize_t(i * slotLen);
+		PyObject *stop = PyLong_FromSsize_t(i * slotLen + viewLen);
+		PyObject *slice = (start && stop) ? PySlice_New(start, stop, NULL) : NULL;
+		Py_XDECREF(start);
+		Py_XDECREF(stop);
+		PyObject *view = slice ? PyObject_GetItem(ring, slice) : NULL;
+		Py_XDECREF(slice);
+		if (!view) {
+			Py_DECREF(views);
+			Py_DECREF(ring);
+			return NULL;
+		}
+		PyTuple_SetItem(views, i, view); // steals reference
+	}
+	Py_DECREF(ring);
+	return views;
+}
+
+static PyObject *opl_stream_impl(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+
+	int frames;
+	if (checkArgCount("stream", nargs, 1, 1) < 0) return NULL;
+	if (intArg(args[0], &frames) < 0) return NULL;
+	if (frames > MAX_SAMPLES) {
+		PyErr_SetString(PyExc_ValueError, "too many frames (max 512 samples)");
+		return NULL;
+	}
+	if (frames < 2) {
+		PyErr_SetString(PyExc_ValueError, "too few frames (min 2 samples)");
+		return NULL;
+	}
+
+	if (!o->ring) {
+		o->ring = (int16_t *)PyMem_Malloc(RING_SLOTS * MAX_SAMPLES * o->channels * SAMPLE_SIZE);
+		if (!o->ring) return PyErr_NoMemory();
+	}
+	// Views are only recreated when the requested length changes, so steady
+	// state playback just hands out the same objects again.
+	if (frames != o->ringFrames) {
+		PyObject *views = opl_makeRingViews(o, frames);
+		if (!views) return NULL;
+		Py_XDECREF(o->ringViews);
+		o->ringViews = views;
+		o->ringFrames = frames;
+	}
+
+	SampleHandler sh(o->channels);
+	sh.setInterleaved(o->ring + o->ringPos * MAX_SAMPLES * o->channels);
+	opl_generate(o, &sh, frames);
+
+	PyObject *view = PyTuple_GetItem(o->ringViews, o->ringPos); // borrowed
+	o->ringPos = (o->ringPos + 1) % RING_SLOTS;
+	Py_INCREF(view);
+	return view;
+}
+
+static PyObject *opl_startCapture_impl(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+
+	delete o->capture;
+	o->capture = new Capture();
+	o->capture->active = true;
+
+	// Start with whatever the chips already hold, so a capture made part way
+	// through a song still plays back.  The OPL3 enable goes first and the
+	// key on registers last, so notes start with their settings in place.
+	for (int pass = 0; pass < 3; pass++) {
+		for (unsigned int reg = 0; reg < (unsigned int)o->numChips << 9; reg++) {
+			unsigned int low = reg & 0xFF;
+			bool keyOn = ((low >= 0xB0) && (low <= 0xB8)) || (low == 0xBD);
+			int wanted = ((reg & 0x1FF) == 0x105) ? 0 : (keyOn ? 2 : 1);
+			if (wanted != pass) continue;
+			Bit8u val = o->opl[reg >> 9].chip.ReadReg(reg & 0x1FF);
+			if (val) o->capture->record(reg, val, 0);
+		}
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject *opl_stopCapture_impl(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	if (o->capture) o->capture->active = false;
+	Py_RETURN_NONE;
+}
+
+// Convert the capture log to a DRO v2 file.  The codemap only lists the
+// registers that were written, in the order they were first used, and the
+// delay codes follow it, as DOSBox does.
+static PyObject *opl_exportDro_impl(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	PyOPL *o = (PyOPL *)self;
+	CHECK_BUSY(o);
+	if (!o->capture) {
+		PyErr_SetString(PyExc_RuntimeError, "nothing captured (call start_capture() first)");
+		return NULL;
+	}
+	const Capture *c = o->capture;
+
+	// A DRO's second bank is either the OPL3's upper registers or a second OPL2
+	int code[256];
+	std::fill(code, code + 256, -1);
+	std::vector<Bit8u> codemap;
+	bool opl3 = false, dual = false;
+	for (const CaptureWrite &w : c->writes) {
+		if ((w.reg >> 9) > 1) {
+			PyErr_SetString(PyExc_ValueError, "DRO files can't hold writes to more than two chips");
+			return NULL;
+		}
+		if (w.reg >> 9) dual = true;
+		if (w.reg & 0x100) opl3 = true;
+		unsigned int low = w.reg & 0xFF;
+		if (code[low] < 0) {
+			code[low] = (int)codemap.size();
+			codemap.push_back((Bit8u)low);
+		}
+	}
+	if (opl3 && dual) {
+		PyErr_SetString(PyExc_ValueError, "DRO files can't hold an OPL3 and a second chip");
+		return NULL;
+	}
+	if (codemap.size() > DRO_MAX_CODES) {
+		PyErr_SetString(PyExc_ValueError, "too many different registers for a DRO codemap");
+		return NULL;
+	}
+	Bit8u shortDelay = (Bit8u)codemap.size();
+	Bit8u longDelay = shortDelay + 1;
+
+	// Delays are rounded to the millisecond from the start of the capture, so
+	// the rounding doesn't add up over a long song
+	std::vector<Bit8u> pairs;
+	pairs.reserve(c->writes.size() * 2);
+	uint64_t frame = 0, ms = 0;
+	auto delayTo = [&](uint64_t at) {
+		uint64_t until = (at * 1000 + o->freq / 2) / o->freq;
+		while (ms < until) {
+			uint64_t delay = until - ms;
+			if (delay >= 256) {
+				uint64_t blocks = std::min(delay >> 8, (uint64_t)256);
+				pairs.push_back(longDelay);
+				pairs.push_back((Bit8u)(blocks - 1));
+				ms += blocks << 8;
+			} else {
+				pairs.push_back(shortDelay);
+				pairs.push_back((Bit8u)(delay - 1));
+				ms += delay;
+			}
+		}
+	};
+	for (const CaptureWrite &w : c->writes) {
+		frame += w.delay;
+		delayTo(frame);
+		pairs.push_back((Bit8u)(code[w.reg & 0xFF] | ((w.reg & 0x300) ? 0x80 : 0)));
+		pairs.push_back(w.val);
+	}
+	delayTo(c->frame);
+
+	static const Bit8u signature[12] = {'D', 'B', 'R', 'A', 'W', 'O', 'P', 'L', 2, 0, 0, 0};
+	Py_ssize_t headerLen = sizeof(signature) + 14;
+	PyObject *out = PyBytes_FromStringAndSize(NULL, headerLen + codemap.size() + pairs.size());
+	if (!out) return NULL;
+	Bit8u *p = (Bit8u *)PyBytes_AsString(out);
+	Bit32u lengthPairs = (Bit32u)(pairs.size() / 2);
+	Bit32u lengthMs = (Bit32u)std::min(ms, (uint64_t)UINT32_MAX);
+	memcpy(p, signature, sizeof(signature));
+	p += sizeof(signature);
+	for (int i = 0; i < 4; i++) *p++ = (Bit8u)(lengthPairs >> (i * 8));
+	for (int i = 0; i < 4; i++) *p++ = (Bit8u)(lengthMs >> (i * 8));
+	*p++ = opl3 ? 2 : (dual ? 1 : 0); // hardware type
+	*p++ = 0; // format: interleaved
+	*p++ = 0; // compression: none
+	*p++ = shortDelay;
+	*p++ = longDelay;
+	*p++ = (Bit8u)codemap.size();
+	if (!codemap.empty()) memcpy(p, codemap.data(), codemap.size());
+	p += codemap.size();
+	if (!pairs.empty()) memcpy(p, pairs.data(), pairs.size());
+	return out;
+}
+
+// Memory owned by the object, so sys.getsizeof() reports the real cost of an instance.
+static PyObject *opl_sizeof_impl(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	PyOPL *o = (PyOPL *)self;
+	size_t size = sizeof(PyOPL);
+	size += o->numChips * sizeof(DBOPL::Handler);
+	for (int i = 0; i < o->numChips; i++) {
+		if (o->opl[i].stemBuffer) size += DBOPL::STEM_LANES * MAX_SAMPLES * 2 * sizeof(Bit32s);
+		if (o->opl[i].previewBuffer) size += DBOPL::STEM_LANES * MAX_SAMPLES * 2 * sizeof(Bit32s);
+	}
+	if (o->mixer) size += sizeof(ChipMixer) + o->numChips * (sizeof(Bit32s[2]) + MAX_SAMPLES * 2 * sizeof(Bit32s));
+	if (o->ring) size += RING_SLOTS * MAX_SAMPLES * o->channels * SAMPLE_SIZE;
+	if (o->capture) size += sizeof(Capture) + o->capture->writes.capacity() * sizeof(CaptureWrite);
+	return PyLong_FromSize_t(size);
+}
+
+PyObject *opl_reset(PyObject *self, PyObject *ignored)
+{
+	LOCKED_CALL(self, opl_reset_impl(self, ignored));
+}
+
+PyObject *opl_writeReg(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+	LOCKED_CALL(self, opl_writeReg_impl(self, args, nargs, kwnames));
+}
+
+PyObject *opl_readReg(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+	LOCKED_CALL(self, opl_readReg_impl(self, args, nargs));
+}
+
+PyObject *opl_setChipPan(PyObject *self, PyObject *args)
+{
+	LOCKED_CALL(self, opl_setChipPan_impl(self, args));
+}
+
+PyObject *opl_setChannelMask(PyObject *self, PyObject *args)
+{
+	LOCKED_CALL(self, opl_setChannelMask_impl(self, args));
+}
+
+PyObject *opl_getSamples(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+	LOCKED_CALL(self, opl_getSamples_impl(self, args, nargs));
+}
+
+PyObject *opl_getStems(PyObject *self, PyObject *args)
+{
+	LOCKED_CALL(self, opl_getStems_impl(self, args));
+}
+
+PyObject *opl_getChipSamples(PyObject *self, PyObject *args)
+{
+	LOCKED_CALL(self, opl_getChipSamples_impl(self, args));
+}
+
+PyObject *opl_render(PyObject *self, PyObject *args, PyObject *keywds)
+{
+	LOCKED_CALL(self, opl_render_impl(self, args, keywds));
+}
+
+PyObject *opl_renderAsync(PyObject *self, PyObject *args, PyObject *keywds)
+{
+	LOCKED_CALL(self, opl_renderAsync_impl(self, args, keywds));
+}
+
+PyObject *opl_stream(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+	LOCKED_CALL(self, opl_stream_impl(self, args, nargs));
+}
+
+PyObject *opl_startCapture(PyObject *self, PyObject *ignored)
+{
+	LOCKED_CALL(self, opl_startCapture_impl(self, ignored));
+}
+
+PyObject *opl_stopCapture(PyObject *self, PyObject *ignored)
+{
+	LOCKED_CALL(self, opl_stopCapture_impl(self, ignored));
+}
+
+PyObject *opl_exportDro(PyObject *self, PyObject *ignored)
+{
+	LOCKED_CALL(self, opl_exportDro_impl(self, ignored));
+}
+
+PyObject *opl_sizeof(PyObject *self, PyObject *ignored)
+{
+	LOCKED_CALL(self, opl_sizeof_impl(self, ignored));
+}
+
+static PyMethodDef opl_methods[] = {
+	{"writeReg",   (PyCFunction)(void(*)(void))opl_writeReg, METH_FASTCALL | METH_KEYWORDS, "writeReg(reg=, val=): Write a value to an OPL register."},
+	{"reset",      (PyCFunction)opl_reset, METH_NOARGS, "reset(): Return every chip to its power-on state."},
+	{"readReg",    (PyCFunction)(void(*)(void))opl_readReg, METH_FASTCALL, "readReg(reg): Return the last value written to an OPL register."},
+	{"getSamples", (PyCFunction)(void(*)(void))opl_getSamples, METH_FASTCALL, "getSamples(buffer[, right]): Fill the supplied buffer, or one buffer per channel, with audio samples."},
+	{"getStems",   (PyCFunction)opl_getStems, METH_VARARGS, "getStems(buffer): Fill the supplied buffer with each channel's samples separately."},
+	{"getChipSamples", (PyCFunction)opl_getChipSamples, METH_VARARGS, "getChipSamples(buffer): Fill the supplied buffer with each chip's samples separately."},
+	{"set_channel_mask", (PyCFunction)opl_setChannelMask, METH_VARARGS, "set_channel_mask(mask[, chip]): Choose which channels are heard, one bit per getStems() lane."},
+	{"set_chip_pan", (PyCFunction)opl_setChipPan, METH_VARARGS, "set_chip_pan(chip, left, right): Set the volume of a chip in each output channel."},
+	{"render",     (PyCFunction)(void(*)(void))opl_render, METH_VARARGS | METH_KEYWORDS, "render(events, buffer, threads=1, groups=1, offset=0, frames=-1): Fill the buffer with audio, making register writes along the way."},
+	{"render_async", (PyCFunction)(void(*)(void))opl_renderAsync, METH_VARARGS | METH_KEYWORDS, "render_async(events, buffer, offset=0, frames=-1): Render on a worker thread, returning an asyncio future."},
+	{"__sizeof__", (PyCFunction)opl_sizeof, METH_NOARGS, "__sizeof__(): Size of the object in memory, in bytes."},
+	{"stream",     (PyCFunction)(void(*)(void))opl_stream, METH_FASTCALL, "stream(frames): Return a read-only memoryview of the next frames of audio."},
+	{"start_capture", (PyCFunction)opl_startCapture, METH_NOARGS, "start_capture(): Start logging register writes, discarding any earlier log."},
+	{"stop_capture", (PyCFunction)opl_stopCapture, METH_NOARGS, "stop_capture(): Stop logging register writes, keeping the log."},
+	{"export_dro", (PyCFunction)opl_exportDro, METH_NOARGS, "export_dro(): Return the logged register writes as a DOSBox Raw OPL v2 file."},
+	{NULL, NULL, 0, NULL}
+};
+
+// Export the stream() ring buffer, read-only, as raw bytes.
+static int opl_getbuffer_impl(PyObject *self, Py_buffer *view, int flags)
+{
+	PyOPL *o = (PyOPL *)self;
+	if (!o->ring) {
+		PyErr_SetString(PyExc_BufferError, "no stream buffer allocated (call stream() first)");
+		return -1;
+	}
+	Py_ssize_t len = RING_SLOTS * MAX_SAMPLES * o->channels * SAMPLE_SIZE;
+	return PyBuffer_FillInfo(view, self, o->ring, len, 1, flags);
+}
+
+int opl_getbuffer(PyObject *self, Py_buffer *view, int flags)
+{
+	int ret;
+	Py_BEGIN_CRITICAL_SECTION(self);
+	ret = opl_getbuffer_impl(self, view, flags);
+	Py_END_CRITICAL_SECTION();
+	return ret;
+}
+
+int opl_traverse(PyObject *self, visitproc visit, void *arg)
+{
+	PyOPL *o = (PyOPL *)self;
+	Py_VISIT(o->ringViews);
+#if PY_VERSION_HEX >= 0x03090000
+	Py_VISIT(Py_TYPE(self));
+#endif
+	return 0;
+}
+
+int opl_clear(PyObject *self)
+{
+	PyOPL *o = (PyOPL *)self;
+	Py_CLEAR(o->ringViews);
+	o->ringFrames = 0;
+	return 0;
+}
+
+void opl_dealloc(PyObject *self)
+{
+	PyOPL *o = (PyOPL *)self;
+	PyTypeObject *tp = Py_TYPE(self);
+	PyObject_GC_UnTrack(self);
+	opl_clear(self);
+	PyMem_Free(o->ring);
+	delete o->mixer;
+	delete o->capture;
+	if (o->arena) releaseArena(o->arena);
+	else delete[] o->opl;
+	freefunc tp_free = (freefunc)PyType_GetSlot(tp, Py_tp_free);
+	tp_free(self);
+	Py_DECREF(tp);
+	return;
+}
+
+PyObject *opl_repr(PyObject *self)
+{
+	return PyString_FromString("<OPL>");
+}
+
+// Check the arguments shared by opl() and pool()
+static int checkFormat(uint8_t sampleSize, uint8_t channels, int chips)
+{
+	if (sampleSize != SAMPLE_SIZE) {
+		PyErr_SetString(PyExc_ValueError, "invalid sample size (valid values: 2=16-bit)");
+		return -1;
+	}
+	if ((channels != 1) && (channels != 2)) {
+		PyErr_SetString(PyExc_ValueError, "invalid channel count (valid values: 1=mono, 2=stereo)");
+		return -1;
+	}
+	if ((chips < 1) || (chips > MAX_CHIPS)) {
+		PyErr_SetString(PyExc_ValueError, "invalid chip count (valid values: 1 to 64)");
+		return -1;
+	}
+	return 0;
+}
+
+// Create an object with its own chips, or with chips borrowed from an arena
+static PyOPL *opl_create(PyTypeObject *type, unsigned int freq, uint8_t channels, int chips,
+	int previewShift, ChipArena *arena, DBOPL::Handler *opl)
+{
+	// Static ABI doesn't allow calling type->tp_alloc.
+	// Just assume the default allocator is used, and call it directly.
+	PyOPL *o = (PyOPL *)PyType_GenericAlloc(type, 0);
+	if (o) {
+		o->channels = channels;
+		o->numChips = chips;
+		o->freq = freq;
+		if (arena) {
+			arena->refs++;
+			o->arena = arena;
+			o->opl = opl;
+		} else {
+			o->opl = new DBOPL::Handler[chips];
+		}
+		for (int i = 0; i < chips; i++) {
+			o->opl[i].SetPreview(previewShift);
+			o->opl[i].Init(freq);
+		}
+		if (chips > 1) o->mixer = new ChipMixer(chips);
+	}
+	return o;
+}
+
+static PyObject *opl_new(PyTypeObject *type, PyObject *args, PyObject *keywds)
+{
+	static const char *kwlist[] = {"freq", "sampleSize", "channels", "chips", "preview", NULL};
+
+	unsigned int freq;
+	uint8_t sampleSize;
+	uint8_t channels;
+	int chips = 1;
+	int preview = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "Ibb|ii", (char **)kwlist, &freq, &sampleSize, &channels, &chips, &preview)) return NULL;
+	if (checkFormat(sampleSize, channels, chips) < 0) return NULL;
+
+	// Preview mode runs the chips at the output rate divided by a power of two
+	int previewShift = 0;
+	while ((previewShift < 31) && ((1 << previewShift) < preview)) previewShift++;
+	if ((preview < 1) || (preview > MAX_PREVIEW) || ((1 << previewShift) != preview)) {
+		PyErr_SetString(PyExc_ValueError, "invalid preview factor (valid values: 1, 2, 4, 8, 16)");
+		return NULL;
+	}
+	if ((freq >> previewShift) == 0) {
+		PyErr_SetString(PyExc_ValueError, "sample rate too low for the preview factor");
+		return NULL;
+	}
+
+	return (PyObject *)opl_create(type, freq, channels, chips, previewShift, NULL, NULL);
+}
+
+static PyType_Slot PyOPLType_spec_slots[] = {
+	{Py_tp_dealloc, (void*)opl_dealloc},
+	{Py_tp_traverse, (void*)opl_traverse},
+	{Py_tp_clear, (void*)opl_clear},
+	{Py_bf_getbuffer, (void*)opl_getbuffer},
+	{Py_tp_repr, (void*)opl_repr},
+	{Py_tp_doc, (void*)"OPL emulator"},
+	{Py_tp_methods, (void*)opl_methods},
+	{Py_tp_new, (void*)opl_new},
+	{0, NULL},
+};
+
+// Must use a dynamic (heap) type in the Static ABI.
+static PyType_Spec PyOPLType_spec = {
+	"pyopl.opl",         // tp_name
+	sizeof(PyOPL),       // tp_basicsize
+	0,                   // tp_itemsize
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, // tp_flags
+	PyOPLType_spec_slots // slots
+};
+
+// A fixed set of opl objects whose chips share one allocation.
+struct PyOPLPool {
+	PyObject_HEAD
+	ChipArena *arena;
+	PyObject **free;      // Objects ready to hand out, used as a stack
+	Py_ssize_t numFree;
+	Py_ssize_t size;
+};
+
+static PyObject *pool_acquire_impl(PyObject *self)
+{
+	PyOPLPool *p = (PyOPLPool *)self;
+	if (!p->numFree) {
+		PyErr_SetString(PyExc_IndexError, "acquire from an empty pool");
+		return NULL;
+	}
+	// The pool's reference passes to the caller
+	PyObject *obj = p->free[--p->numFree];
+	((PyOPL *)obj)->pooled = 0;
+	return obj;
+}
+
+PyObject *pool_acquire(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	LOCKED_CALL(self, pool_acquire_impl(self));
+}
+
+static PyObject *pool_release_impl(PyObject *self, PyObject *obj)
+{
+	PyOPLPool *p = (PyOPLPool *)self;
+	PyOPL *o = (PyOPL *)obj;
+	if (o->arena != p->arena) {
+		PyErr_SetString(PyExc_ValueError, "opl object did not come from this pool");
+		return NULL;
+	}
+	if (o->pooled) {
+		PyErr_SetString(PyExc_ValueError, "opl object has already been released");
+		return NULL;
+	}
+	CHECK_BUSY(o);
+	opl_resetState(o);
+	o->pooled = 1;
+	Py_INCREF(obj);
+	p->free[p->numFree++] = obj;
+	Py_RETURN_NONE;
+}
+
+PyObject *pool_release(PyObject *self, PyObject *args)
+{
+	PyObject *obj, *ret;
+	PyTypeObject *oplType = (PyTypeObject *)typeState(Py_TYPE(self))->oplType;
+	if (!PyArg_ParseTuple(args, "O!", oplType, &obj)) return NULL;
+
+	// Both the pool and the object being reset need to be locked
+	Py_BEGIN_CRITICAL_SECTION2(self, obj);
+	ret = pool_release_impl(self, obj);
+	Py_END_CRITICAL_SECTION2();
+	return ret;
+}
+
+Py_ssize_t pool_length(PyObject *self)
+{
+	Py_ssize_t len;
+	Py_BEGIN_CRITICAL_SECTION(self);
+	len = ((PyOPLPool *)self)->numFree;
+	Py_END_CRITICAL_SECTION();
+	return len;
+}
+
+int pool_clear(PyObject *self)
+{
+	PyOPLPool *p = (PyOPLPool *)self;
+	while (p->numFree) Py_CLEAR(p->free[--p->numFree]);
+	return 0;
+}
+
+int pool_traverse(PyObject *self, visitproc visit, void *arg)
+{
+	PyOPLPool *p = (PyOPLPool *)self;
+	for (Py_ssize_t i = 0; i < p->numFree; i++) Py_VISIT(p->free[i]);
+#if PY_VERSION_HEX >= 0x03090000
+	Py_VISIT(Py_TYPE(self));
+#endif
+	return 0;
+}
+
+void pool_dealloc(PyObject *self)
+{
+	PyOPLPool *p = (PyOPLPool *)self;
+	PyTypeObject *tp = Py_TYPE(self);
+	PyObject_GC_UnTrack(self);
+	pool_clear(self);
+	PyMem_Free(p->free);
+	if (p->arena) releaseArena(p->arena);
+	freefunc tp_free = (freefunc)PyType_GetSlot(tp, Py_tp_free);
+	tp_free(self);
+	Py_DECREF(tp);
+}
+
+static PyObject *pool_new(PyTypeObject *type, PyObject *args, PyObject *keywds)
+{
+	static const char *kwlist[] = {"size", "freq", "sampleSize", "channels", "chips", NULL};
+
+	Py_ssize_t size;
+	unsigned int freq;
+	uint8_t sampleSize;
+	uint8_t channels;
+	int chips = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "nIbb|i", (char **)kwlist, &size, &freq, &sampleSize, &channels, &chips)) return NULL;
+	if (checkFormat(sampleSize, channels, chips) < 0) return NULL;
+	if (size < 1) {
+		PyErr_SetString(PyExc_ValueError, "pool size must be at least 1");
+		return NULL;
+	}
+
+	PyOPLPool *p = (PyOPLPool *)PyType_GenericAlloc(type, 0);
+	if (!p) return NULL;
+	p->size = size;
+	p->free = (PyObject **)PyMem_Calloc(size, sizeof(PyObject *));
+	if (!p->free) {
+		Py_DECREF(p);
+		return PyErr_NoMemory();
+	}
+	p->arena = new ChipArena();
+	p->arena->chips = new DBOPL::Handler[size * chips];
+	p->arena->refs = 1;
+	for (Py_ssize_t i = 0; i < size; i++) {
+		PyOPL *o = opl_create((PyTypeObject *)typeState(type)->oplType, freq, channels, chips,
+			0, p->arena, p->arena->chips + i * chips);
+		if (!o) {
+			Py_DECREF(p);
+			return NULL;
+		}
+		o->pooled = 1;
+		p->free[p->numFree++] = (PyObject *)o;
+	}
+	return (PyObject *)p;
+}
+
+static PyMethodDef pool_methods[] = {
+	{"acquire", (PyCFunction)pool_acquire, METH_NOARGS, "acquire(): Take a freshly reset opl object out of the pool."},
+	{"release", (PyCFunction)pool_release, METH_VARARGS, "release(opl): Reset an opl object and return it to the pool."},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyType_Slot PyOPLPoolType_spec_slots[] = {
+	{Py_tp_dealloc, (void*)pool_dealloc},
+	{Py_tp_traverse, (void*)pool_traverse},
+	{Py_tp_clear, (void*)pool_clear},
+	{Py_sq_length, (void*)pool_length},
+	{Py_tp_doc, (void*)"Pool of OPL emulators sharing one block of memory"},
+	{Py_tp_methods, (void*)pool_methods},
+	{Py_tp_new, (void*)pool_new},
+	{0, NULL},
+};
+
+static PyType_Spec PyOPLPoolType_spec = {
+	"pyopl.pool",            // tp_name
+	sizeof(PyOPLPool),       // tp_basicsize
+	0,                       // tp_itemsize
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, // tp_flags
+	PyOPLPoolType_spec_slots // slots
+};
+
+// Writes blocks of samples to a file on its own thread, so the next block can
+// be rendered while the last one is being written.
+struct SinkWriter {
+	int fd;
+	std::vector<int16_t> buffers[2];
+	size_t pending[2]; // Bytes waiting to be written from each buffer
+	int fill;          // Buffer the renderer fills next
+	int err;           // errno of the first failed write, or 0
+	bool stop;
+	std::mutex lock;
+	std::condition_variable cond;
+	std::thread thread;
+
+	SinkWriter(int fd, size_t samples)
+		: fd(fd), pending{0, 0}, fill(0), err(0), stop(false)
+	{
+		buffers[0].resize(samples);
+		buffers[1].resize(samples);
+		thread = std::thread(&SinkWriter::run, this);
+	}
+
+	// Wait for the next buffer to be written, and return it for filling
+	int16_t *next()
+	{
+		std::unique_lock<std::mutex> l(lock);
+		cond.wait(l, [this] { return !pending[fill]; });
+		return buffers[fill].data();
+	}
+
+	// Hand the buffer returned by next() to the writer
+	void post(size_t bytes)
+	{
+		{
+			std::lock_guard<std::mutex> l(lock);
+			pending[fill] = bytes;
+			fill ^= 1;
+		}
+		cond.notify_all();
+	}
+
+	// Wait for everything posted to be written, and return the first error
+	int drain()
+	{
+		std::unique_lock<std::mutex> l(lock);
+		cond.wait(l, [this] { return !pending[0] && !pending[1]; });
+		return err;
+	}
+
+	// Write everything posted, then end the thread
+	int finish()
+	{
+		{
+			std::lock_guard<std::mutex> l(lock);
+			stop = true;
+		}
+		cond.notify_all();
+		thread.join();
+		return err;
+	}
+
+	void run()
+	{
+		int i = 0;
+		std::unique_lock<std::mutex> l(lock);
+		for (;;) {
+			cond.wait(l, [this, i] { return pending[i] || stop; });
+			if (!pending[i]) return;
+			l.unlock();
+			// After a failure the rest is dropped, as the file is broken anyway
+			const char *buf = (const char *)buffers[i].data();
+			size_t left = err ? 0 : pending[i];
+			while (left) {
+				auto written = fileWrite(fd, buf, left);
+				if (written < 0) {
+					if (errno == EINTR) continue;
+					err = errno;
+					break;
+				}
+				buf += written;
+				left -= written;
+			}
+			l.lock();
+			pending[i] = 0;
+			i ^= 1;
+			cond.notify_all();
+		}
+	}
+};
+
+// Renders audio from an opl object into a file, as WAV or raw samples.
+struct PyOPLSink {
+	PyObject_HEAD
+	PyObject *synth;      // The opl object being rendered
+	PyObject *file;       // The caller's file, which is never closed
+	int fd;               // Our own duplicate of its descriptor, so it can't be reused under us
+	int wav;
+	uint8_t channels;
+	unsigned int freq;
+	long long start;      // File offset of the first byte written, or -1 if the file can't seek
+	uint64_t frames;      // Frames rendered so far
+	SinkWriter *writer;   // NULL when memory-mapped or closed
+	PyObject *map;        // mmap.mmap object when memory-mapped
+	Py_buffer view;       // The mapped memory
+	uint64_t mapFrames;   // Frames the mapped file has room for
+	int busy;             // Set while render() runs without the GIL
+	int closed;
+};
+
+// Fill in a WAV header for the given number of frames.  Sizes too large for
+// the header are left at their maximum, which readers take as "until the end
+// of the file".
+static void sink_makeHeader(PyOPLSink *s, uint64_t frames, Bit8u *h)
+{
+	uint64_t dataLen = frames * s->channels * SAMPLE_SIZE;
+	Bit32u data32 = (Bit32u)std::min(dataLen, (uint64_t)UINT32_MAX - (WAV_HEADER_SIZE - 8));
+	Bit32u fields[] = {
+		0x46464952, data32 + WAV_HEADER_SIZE - 8, 0x45564157, // "RIFF", size, "WAVE"
+		0x20746D66, 16, (Bit32u)(1 | (s->channels << 16)),    // "fmt ", size, PCM
+		s->freq, s->freq * s->channels * SAMPLE_SIZE,
+		(Bit32u)((s->channels * SAMPLE_SIZE) | ((SAMPLE_SIZE * 8) << 16)),
+		0x61746164, data32,                                   // "data", size
+	};
+	for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+		for (int b = 0; b < 4; b++) *h++ = (Bit8u)(fields[i] >> (b * 8));
+	}
+}
+
+// Start of the audio in the mapped file
+static int16_t *sink_mapped(PyOPLSink *s)
+{
+	return (int16_t *)((char *)s->view.buf + s->start + (s->wav ? WAV_HEADER_SIZE : 0));
+}
+
+// Render a list of writes in chunks, each starting where a single render()
+// call would start a block so the output is the same.
+static void sink_renderChunks(PyOPLSink *s, PyOPL *o, const RenderEvent *ev,
+	const RenderEvent *evEnd, Py_ssize_t total)
+{
+	Py_ssize_t frame = 0;
+	while (frame < total) {
+		Py_ssize_t endFrame = std::min(total, blockBoundary(ev, evEnd, frame + SINK_CHUNK_SAMPLES));
+		SampleHandler sh(o->channels);
+		if (s->writer) {
+			sh.setInterleaved(s->writer->next());
+		} else {
+			sh.setInterleaved(sink_mapped(s) + (s->frames + frame) * o->channels);
+		}
+		renderRange(o, &sh, ev, evEnd, frame, endFrame);
+		if (s->writer) s->writer->post((endFrame - frame) * o->channels * SAMPLE_SIZE);
+		frame = endFrame;
+	}
+}
+
+// Raise OSError for an errno value
+static PyObject *sink_error(int err)
+{
+	errno = err;
+	return PyErr_SetFromErrno(PyExc_OSError);
+}
+
+static PyObject *sink_render_impl(PyObject *self, PyObject *events, Py_ssize_t frames)
+{
+	PyOPLSink *s = (PyOPLSink *)self;
+	if (s->closed) {
+		PyErr_SetString(PyExc_ValueError, "render on a closed sink");
+		return NULL;
+	}
+	PyOPL *o = (PyOPL *)s->synth;
+	CHECK_BUSY(s);
+	CHECK_BUSY(o);
+	if (frames < 0) {
+		PyErr_SetString(PyExc_ValueError, "invalid frame count (min 0)");
+		return NULL;
+	}
+	if (s->map && (s->frames + frames > s->mapFrames)) {
+		PyErr_SetString(PyExc_ValueError, "render would run past the end of the mapped file");
+		return NULL;
+	}
+
+	std::vector<RenderEvent> list;
+	s->busy = o->busy = 1;
+	if (collectEvents(o, events, frames, &list) < 0) {
+		s->busy = o->busy = 0;
+		return NULL;
+	}
+	captureEvents(o, list.data(), list.data() + list.size(), frames);
+	int err = 0;
+	Py_BEGIN_ALLOW_THREADS
+	const RenderEvent *ev = list.data(), *evEnd = ev + list.size();
+	sink_renderChunks(s, o, ev, evEnd, frames);
+	applyEndWrites(o, ev, evEnd, frames);
+	// Only earlier writes are checked, so the last chunk is still being
+	// written when this returns
+	if (s->writer) {
+		std::lock_guard<std::mutex> l(s->writer->lock);
+		err = s->writer->err;
+	}
+	Py_END_ALLOW_THREADS
+	s->busy = o->busy = 0;
+	s->frames += frames;
+
+	if (err) return sink_error(err);
+	Py_RETURN_NONE;
+}
+
+PyObject *sink_render(PyObject *self, PyObject *args, PyObject *keywds)
+{
+	static const char *kwlist[] = {"events", "frames", NULL};
+	PyObject *events, *ret;
+	Py_ssize_t frames;
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "On", (char **)kwlist, &events, &frames)) return NULL;
+
+	// Both the sink and the object it renders need to be locked
+	Py_BEGIN_CRITICAL_SECTION2(self, ((PyOPLSink *)self)->synth);
+	ret = sink_render_impl(self, events, frames);
+	Py_END_CRITICAL_SECTION2();
+	return ret;
+}
+
+// Finish writing the file and patch the WAV header with its length
+static int sink_close_impl(PyOPLSink *s)
+{
+	if (s->closed) return 0;
+	s->closed = 1;
+
+	int err = 0;
+	if (s->writer) {
+		SinkWriter *writer = s->writer;
+		s->writer = NULL;
+		Py_BEGIN_ALLOW_THREADS
+		err = writer->finish();
+		delete writer;
+		Py_END_ALLOW_THREADS
+	}
+
+	Bit8u header[WAV_HEADER_SIZE];
+	sink_makeHeader(s, s->frames, header);
+	if (s->map) {
+		if (s->wav) memcpy((char *)s->view.buf + s->start, header, WAV_HEADER_SIZE);
+		PyBuffer_Release(&s->view);
+		PyObject *ret = PyObject_CallMethod(s->map, "close", NULL);
+		Py_CLEAR(s->map);
+		if (!ret) {
+			fileClose(s->fd);
+			s->fd = -1;
+			return -1;
+		}
+		Py_DECREF(ret);
+		// Trim the file to what was rendered, and leave the position after it
+		long long end = s->start + (s->wav ? WAV_HEADER_SIZE : 0) + s->frames * s->channels * SAMPLE_SIZE;
+		ret = callModule("os", "ftruncate", "(iL)", s->fd, end);
+		if (!ret) {
+			fileClose(s->fd);
+			s->fd = -1;
+			return -1;
+		}
+		Py_DECREF(ret);
+		if (fileSeek(s->fd, end, SEEK_SET) < 0) err = errno;
+	} else if (s->wav && (s->start >= 0) && !err) {
+		long long end = fileSeek(s->fd, 0, SEEK_CUR);
+		if ((end < 0)
+			|| (fileSeek(s->fd, s->start, SEEK_SET) < 0)
+			|| (fileWrite(s->fd, header, WAV_HEADER_SIZE) != WAV_HEADER_SIZE)
+			|| (fileSeek(s->fd, end, SEEK_SET) < 0)
+		) {
+			err = errno;
+		}
+	}
+	fileClose(s->fd);
+	s->fd = -1;
+	if (err) {
+		sink_error(err);
+		return -1;
+	}
+	return 0;
+}
+
+static PyObject *sink_closeMethod_impl(PyObject *self)
+{
+	PyOPLSink *s = (PyOPLSink *)self;
+	CHECK_BUSY(s);
+	if (sink_close_impl(s) < 0) return NULL;
+	Py_RETURN_NONE;
+}
+
+PyObject *sink_close(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	LOCKED_CALL(self, sink_closeMethod_impl(self));
+}
+
+PyObject *sink_enter(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+	Py_INCREF(self);
+	return self;
+}
+
+PyObject *sink_exit(PyObject *self, PyObject *Py_UNUSED(args))
+{
+	return sink_close(self, NULL);
+}
+
+int sink_traverse(PyObject *self, visitproc visit, void *arg)
+{
+	PyOPLSink *s = (PyOPLSink *)self;
+	Py_VISIT(s->synth);
+	Py_VISIT(s->file);
+#if PY_VERSION_HEX >= 0x03090000
+	Py_VISIT(Py_TYPE(self));
+#endif
+	return 0;
+}
+
+int sink_clear(PyObject *self)
+{
+	PyOPLSink *s = (PyOPLSink *)self;
+	Py_CLEAR(s->synth);
+	Py_CLEAR(s->file);
+	return 0;
+}
+
+void sink_dealloc(PyObject *self)
+{
+	PyOPLSink *s = (PyOPLSink *)self;
+	PyTypeObject *tp = Py_TYPE(self);
+	PyObject_GC_UnTrack(self);
+	// An unclosed file is still finished off, but any error can only be
+	// reported as unraisable, against the type as the object is going
+	if (!s->closed) {
+		PyObject *type, *value, *tb;
+		PyErr_Fetch(&type, &value, &tb);
+		if (sink_close_impl(s) < 0) PyErr_WriteUnraisable((PyObject *)tp);
+		PyErr_Restore(type, value, tb);
+	}
+	// Left open when creating the sink failed
+	if (s->fd >= 0) fileClose(s->fd);
+	sink_clear(self);
+	freefunc tp_free = (freefunc)PyType_GetSlot(tp, Py_tp_free);
+	tp_free(self);
+	Py_DECREF(tp);
+}
+
+static PyObject *sink_new(PyTypeObject *type, PyObject *args, PyObject *keywds)
+{
+	static const char *kwlist[] = {"synth", "file", "wav", "mmap_frames", NULL};
+
+	PyObject *synth, *file;
+	int wav = 1;
+	Py_ssize_t mapFrames = 0;
+	PyTypeObject *oplType = (PyTypeObject *)typeState(type)->oplType;
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "O!O|pn", (char **)kwlist, oplType, &synth, &file, &wav, &mapFrames)) return NULL;
+	if (mapFrames < 0) {
+		PyErr_SetString(PyExc_ValueError, "invalid mmap_frames (min 0)");
+		return NULL;
+	}
+	int fd = PyObject_AsFileDescriptor(file);
+	if (fd < 0) return NULL;
+	// Closing the file before the sink then leaves the header and the last
+	// writes going where they should, not into whatever reuses the number
+	fd = fileDup(fd);
+	if (fd < 0) return sink_error(errno);
+
+	PyOPLSink *s = (PyOPLSink *)PyType_GenericAlloc(type, 0);
+	if (!s) {
+		fileClose(fd);
+		return NULL;
+	}
+	PyOPL *o = (PyOPL *)synth;
+	Py_INCREF(synth);
+	s->synth = synth;
+	Py_INCREF(file);
+	s->file = file;
+	s->fd = fd;
+	s->wav = wav;
+	s->channels = o->channels;
+	s->freq = o->freq;
+	s->start = fileSeek(fd, 0, SEEK_CUR);
+
+	Bit8u header[WAV_HEADER_SIZE];
+	sink_makeHeader(s, UINT32_MAX, header);
+	if (mapFrames) {
+		if (s->start < 0) {
+			s->closed = 1;
+			Py_DECREF(s);
+			PyErr_SetString(PyExc_ValueError, "memory-mapped sinks need a file that can seek");
+			return NULL;
+		}
+		// The mmap module works the same everywhere, and can grow the file
+		long long length = s->start + (wav ? WAV_HEADER_SIZE : 0) + mapFrames * s->channels * SAMPLE_SIZE;
+		PyObject *ret = callModule("os", "ftruncate", "(iL)", fd, length);
+		if (ret) {
+			Py_DECREF(ret);
+			s->map = callModule("mmap", "mmap", "(iL)", fd, length);
+		}
+		if (!s->map || (PyObject_GetBuffer(s->map, &s->view, PyBUF_WRITABLE) < 0)) {
+			Py_CLEAR(s->map);
+			s->closed = 1;
+			Py_DECREF(s);
+			return NULL;
+		}
+		s->mapFrames = mapFrames;
+		if (wav) memcpy((char *)s->view.buf + s->start, header, WAV_HEADER_SIZE);
+	} else {
+		// The header is patched with the real length on close, if the file can seek
+		if (wav && (fileWrite(fd, header, WAV_HEADER_SIZE) != WAV_HEADER_SIZE)) {
+			s->closed = 1;
+			Py_DECREF(s);
+			return sink_error(errno);
+		}
+		s->writer = new SinkWriter(fd, (SINK_CHUNK_SAMPLES + MAX_SAMPLES) * s->channels);
+	}
+	return (PyObject *)s;
+}
+
+static PyMethodDef sink_methods[] = {
+	{"render",    (PyCFunction)(void(*)(void))sink_render, METH_VARARGS | METH_KEYWORDS, "render(events, frames): Render audio into the file, making register writes along the way."},
+	{"close",     (PyCFunction)sink_close, METH_NOARGS, "close(): Finish writing the file."},
+	{"__enter__", (PyCFunction)sink_enter, METH_NOARGS, "__enter__(): Return the sink."},
+	{"__exit__",  (PyCFunction)sink_exit, METH_VARARGS, "__exit__(*exc): Close the sink."},
+	{NULL, NULL, 0, NULL}
+};
+
+static PyType_Slot PyOPLSinkType_spec_slots[] = {
+	{Py_tp_dealloc, (void*)sink_dealloc},
+	{Py_tp_traverse, (void*)sink_traverse},
+	{Py_tp_clear, (void*)sink_clear},
+	{Py_tp_doc, (void*)"Renders an OPL emulator's audio into a file"},
+	{Py_tp_methods, (void*)sink_methods},
+	{Py_tp_new, (void*)sink_new},
+	{0, NULL},
+};
+
+static PyType_Spec PyOPLSinkType_spec = {
+	"pyopl.sink",            // tp_name
+	sizeof(PyOPLSink),       // tp_basicsize
+	0,                       // tp_itemsize
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC, // tp_flags
+	PyOPLSinkType_spec_slots // slots
+};
+
+static PyMethodDef methods[] = {
+	{NULL, NULL, 0, NULL}
+};
+
+// Create a type belonging to the module, so its methods can find the module state
+static PyObject *moduleType(PyObject *module, PyType_Spec *spec)
+{
+#if PY_VERSION_HEX >= 0x03090000
+	return PyType_FromModuleAndSpec(module, spec, NULL);
+#else
+	return PyType_FromSpec(spec);
+#endif
+}
+
+// Registered with atexit, so the render_async() workers are stopped while
+// they can still take the GIL
+static PyObject *pyopl_stopAsync(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+	async_shutdown((ModuleState *)PyModule_GetState(module));
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef stopAsyncDef = {"_stop_async", (PyCFunction)pyopl_stopAsync, METH_NOARGS, NULL};
+
+static int pyopl_exec(PyObject *module)
+{
+	ModuleState *state = (ModuleState *)PyModule_GetState(module);
+#if PY_VERSION_HEX < 0x03090000
+	lastState = state;
+#endif
+
+	state->oplType = moduleType(module, &PyOPLType_spec);
+	if (!state->oplType) return -1;
+	Py_INCREF(state->oplType);
+	if (PyModule_AddObject(module, "opl", state->oplType) < 0) {
+		Py_DECREF(state->oplType);
+		return -1;
+	}
+
+	state->poolType = moduleType(module, &PyOPLPoolType_spec);
+	if (!state->poolType) return -1;
+	Py_INCREF(state->poolType);
+	if (PyModule_AddObject(module, "pool", state->poolType) < 0) {
+		Py_DECREF(state->poolType);
+		return -1;
+	}
+
+	state->sinkType = moduleType(module, &PyOPLSinkType_spec);
+	if (!state->sinkType) return -1;
+	Py_INCREF(state->sinkType);
+	if (PyModule_AddObject(module, "sink", state->sinkType) < 0) {
+		Py_DECREF(state->sinkType);
+		return -1;
+	}
+
+	if (PyModule_AddIntConstant(module, "STEM_LANES", DBOPL::STEM_LANES) < 0) return -1;
+
+	PyObject *stopAsync = PyCFunction_NewEx(&stopAsyncDef, module, NULL);
+	PyObject *ret = stopAsync ? callModule("atexit", "register", "(O)", stopAsync) : NULL;
+	Py_XDECREF(stopAsync);
+	if (!ret) return -1;
+	Py_DECREF(ret);
+	return 0;
+}
+
+static int pyopl_traverse(PyObject *module, visitproc visit, void *arg)
+{
+	ModuleState *state = (ModuleState *)PyModule_GetState(module);
+	Py_VISIT(state->oplType);
+	Py_VISIT(state->poolType);
+	Py_VISIT(state->sinkType);
+	return 0;
+}
+
+static int pyopl_clear(PyObject *module)
+{
+	ModuleState *state = (ModuleState *)PyModule_GetState(module);
+	Py_CLEAR(state->oplType);
+	Py_CLEAR(state->poolType);
+	Py_CLEAR(state->sinkType);
+	return 0;
+}
+
+static void pyopl_free(void *module)
+{
+	ModuleState *state = (ModuleState *)PyModule_GetState((PyObject *)module);
+	async_shutdown(state);
+	delete state->asyncPool;
+	state->asyncPool = NULL;
+	pyopl_clear((PyObject *)module);
+}
+
+// Slots newer than the oldest Python the build supports, which older versions
+// reject, so there is one module definition for each set of slots.
+#ifndef Py_mod_multiple_interpreters
+#define Py_mod_multiple_interpreters 3
+#endif
+#ifndef Py_MOD_PER_INTERPRETER_GIL_SUPPORTED
+#define Py_MOD_PER_INTERPRETER_GIL_SUPPORTED ((void *)2)
+#endif
+#ifndef Py_mod_gil
+#define Py_mod_gil 4
+#endif
+#ifndef Py_MOD_GIL_NOT_USED
+#define Py_MOD_GIL_NOT_USED ((void *)1)
+#endif
+
+// Every object and type belongs to one interpreter, and the chip tables are
+// either constant or locked, so neither the GIL nor sharing it is needed.
+static PyModuleDef_Slot slots[] = {
+	{Py_mod_exec, (void*)pyopl_exec},
+	{Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+	{Py_mod_gil, Py_MOD_GIL_NOT_USED},
+	{0, NULL},
+};
+static PyModuleDef_Slot slots312[] = {
+	{Py_mod_exec, (void*)pyopl_exec},
+	{Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+	{0, NULL},
+};
+static PyModuleDef_Slot slots311[] = {
+	{Py_mod_exec, (void*)pyopl_exec},
+	{0, NULL},
+};
+
+#define PYOPL_MODULE_DEF(slots) { \
+	PyModuleDef_HEAD_INIT, /* m_base */ \
+	"pyopl",        /* m_name */ \
+	NULL,           /* m_doc */ \
+	sizeof(ModuleState), /* m_size */ \
+	methods,        /* m_methods */ \
+	slots,          /* m_slots */ \
+	pyopl_traverse, /* m_traverse */ \
+	pyopl_clear,    /* m_clear */ \
+	pyopl_free,     /* m_free */ \
+}
+
+static struct PyModuleDef pyoplmodule311 = PYOPL_MODULE_DEF(slots311);
+static struct PyModuleDef pyoplmodule312 = PYOPL_MODULE_DEF(slots312);
+static struct PyModuleDef pyoplmodule = PYOPL_MODULE_DEF(slots);
+
+// Version of the running interpreter, which stable ABI builds only know at runtime
+#ifdef Py_LIMITED_API
+#define RUNTIME_VERSION Py_Version
+#else
+#define RUNTIME_VERSION PY_VERSION_HEX
+#endif
+
+PyMODINIT_FUNC
+PyInit_pyopl(void)
+{
+	if (RUNTIME_VERSION < 0x030C0000) return PyModuleDef_Init(&pyoplmodule311);
+	if (RUNTIME_VERSION < 0x030D0000) return PyModuleDef_Init(&pyoplmodule312);
+	return PyModuleDef_Init(&pyoplmodule);
 }
@@ -1,11 +1,19 @@
+import os
 import sys
+import sysconfig
 
 from setuptools import Extension, setup
 from wheel.bdist_wheel import bdist_wheel
 
-is_stable_api_supported = sys.version_info.major >= 3 and sys.version_info.minor >= 11
+is_free_threaded = bool(sysconfig.get_config_var("Py_GIL_DISABLED"))
+"""Free-threaded (PEP 703) builds have no stable ABI, so get a version specific build."""
+
+is_stable_api_supported = sys.version_info.major >= 3 and sys.version_info.minor >= 11 and not is_free_threaded
 """The minimum supported version for stable ABI (limited API) is 3.11, due to use of Buffer."""
 
+is_usdt = bool(os.environ.get("PYOPL_USDT"))
+"""Static tracepoints for perf and bpftrace, which need sys/sdt.h (systemtap-sdt-dev)."""
+
 
 class bdist_wheel_abi3(bdist_wheel):
 	def get_tag(self):
@@ -24,8 +32,9 @@ setup(
 		Extension(
 			'pyopl',
 			['pyopl.cpp', 'dbopl.cpp'],
-			define_macros=[("Py_LIMITED_API", "0x030B0000")] if is_stable_api_supported else [],
-			depends=['dosbox.h', 'dbopl.h', 'adlib.h'],
+			define_macros=([("Py_LIMITED_API", "0x030B0000")] if is_stable_api_supported else [])
+				+ ([("PYOPL_USDT", "1")] if is_usdt else []),
+			depends=['dosbox.h', 'dbopl.h', 'dbopl_tables.h', 'adlib.h'],
 			py_limited_api=is_stable_api_supported,
 		)
 	],
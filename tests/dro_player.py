@@ -18,7 +18,7 @@ def read_dro(file_name: str) -> "DROData":
 		(
 			length_pairs,  # unused
 			length_ms,  # unused
-			hardware_type,  # unused
+			hardware_type,
 			dro_format,  # unused
 			compression,  # unused
 			short_delay_code,
@@ -28,7 +28,7 @@ def read_dro(file_name: str) -> "DROData":
 		codemap = struct.unpack(str(codemap_length) + "B", drof.read(codemap_length))
 		raw_data = array.array("B")
 		raw_data.fromfile(drof, length_pairs * 2)
-		return DROData(codemap, raw_data, short_delay_code, long_delay_code)
+		return DROData(codemap, raw_data, short_delay_code, long_delay_code, hardware_type)
 
 
 class DROInstructionType(Enum):
@@ -42,12 +42,14 @@ class DROData:
 			codemap: typing.Tuple[int, ...],
 			raw_data: array.array,
 			short_delay_code: int,
-			long_delay_code: int
+			long_delay_code: int,
+			hardware_type: int = 0
 	) -> None:
 		self._codemap = codemap
 		self._raw_data = raw_data
 		self._short_delay_code = short_delay_code
 		self._long_delay_code = long_delay_code
+		self.hardware_type = hardware_type
 
 	def __iter__(self) -> typing.Iterator[
 		typing.Union[
@@ -75,18 +77,25 @@ class DROData:
 
 
 class DROPlayer:
-	def __init__(self, file_name: str) -> None:
+	def __init__(self, file_name: str, preview: int = 1) -> None:
 		self._bit_depth = 16
 		self._buffer_size = 512
 		self._channels = 2
 		self._buffer = self._create_bytearray(self._buffer_size)
 		self._dro = read_dro(file_name)
 		self._frequency = 49716
+		# Dual OPL2 puts the second bank on a second chip, panned right
+		self._dual_opl2 = self._dro.hardware_type == 1
 		self._opl: pyopl.opl = pyopl.opl(
 			self._frequency,
 			sampleSize=(self._bit_depth // 8),
 			channels=self._channels,
+			chips=2 if self._dual_opl2 else 1,
+			preview=preview,
 		)
+		if self._dual_opl2:
+			self._opl.set_chip_pan(0, 1.0, 0.0)
+			self._opl.set_chip_pan(1, 0.0, 1.0)
 		self._sample_overflow = 0
 		self._output = bytes()
 
@@ -118,9 +127,7 @@ class DROPlayer:
 
 	def render_dro(self):
 		# Reset (may not be required)
-		for bank in range(2):
-			for reg in range(0x100):
-				self._write(bank, reg, 0x00)
+		self._opl.reset()
 
 		# Render all instructions
 		for entry in self._dro:
@@ -134,4 +141,7 @@ class DROPlayer:
 		return self._output
 
 	def _write(self, bank: int, register: int, value: int) -> None:
-		self._opl.writeReg(register | (bank << 2), value)
+		if self._dual_opl2:
+			self._opl.writeReg(register | (bank << 9), value)
+		else:
+			self._opl.writeReg(register | (bank << 2), value)
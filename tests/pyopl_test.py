@@ -1,8 +1,41 @@
-from .dro_player import DROPlayer
+from .dro_player import DROInstructionType, DROPlayer, read_dro
+import array
+import asyncio
+import math
 from pathlib import Path
+import pyopl
+import runpy
+import subprocess
+import sys
+import tempfile
+import threading
 import unittest
 import wave
 
+try:
+	import numpy
+except ImportError:
+	numpy = None
+
+try:
+	import _interpreters
+except ImportError:
+	_interpreters = None
+
+
+def play_note(opl: pyopl.opl, bank: int = 0, fnum: int = 0x98) -> None:
+	"""Key on a plain sine tone on channel 0."""
+	opl.writeReg(bank | 0x20, 0x01)
+	opl.writeReg(bank | 0x23, 0x01)
+	opl.writeReg(bank | 0x40, 0x10)
+	opl.writeReg(bank | 0x43, 0x00)
+	opl.writeReg(bank | 0x60, 0xF0)
+	opl.writeReg(bank | 0x63, 0xF0)
+	opl.writeReg(bank | 0x80, 0x77)
+	opl.writeReg(bank | 0x83, 0x77)
+	opl.writeReg(bank | 0xA0, fnum)
+	opl.writeReg(bank | 0xB0, 0x31)
+
 
 class PyOPLTestCase(unittest.TestCase):
 	def test_dro_rendering(self) -> None:
@@ -24,6 +57,869 @@ class PyOPLTestCase(unittest.TestCase):
 
 		self.assertEqual(rendered_data, wav_data)
 
+	def test_stream(self) -> None:
+		reference = pyopl.opl(49716, sampleSize=2, channels=2)
+		streamed = pyopl.opl(49716, sampleSize=2, channels=2)
+		play_note(reference)
+		play_note(streamed)
+
+		buffer = bytearray(256 * 2 * 2)
+		views = []
+		for _ in range(8):
+			reference.getSamples(buffer)
+			view = streamed.stream(256)
+			self.assertTrue(view.readonly)
+			self.assertEqual(view.tobytes(), buffer)
+			views.append(view)
+
+		# Steady state playback keeps handing out the same ring slots
+		self.assertIs(views[0], views[4])
+		self.assertIsNot(views[0], views[1])
+		self.assertRaises(ValueError, streamed.stream, 513)
+
+	def test_output_layouts(self) -> None:
+		synths = [pyopl.opl(49716, sampleSize=2, channels=2) for _ in range(4)]
+		for synth in synths:
+			synth.writeReg(0x105, 0x01)  # OPL3 mode, for true stereo
+			synth.writeReg(0xC0, 0x10)  # Left only
+			play_note(synth)
+
+		interleaved = array.array("h", bytes(128 * 2 * 2))
+		synths[0].getSamples(interleaved)
+		self.assertTrue(any(interleaved[0::2]))
+		self.assertFalse(any(interleaved[1::2]))
+
+		# One buffer per channel
+		left = array.array("h", bytes(128 * 2))
+		right = bytearray(128 * 2)
+		synths[1].getSamples(left, right)
+		self.assertEqual(left, interleaved[0::2])
+		self.assertEqual(right, bytes(128 * 2))
+
+		# 2D (samples, channels) view over an interleaved buffer
+		shaped = bytearray(128 * 2 * 2)
+		synths[2].getSamples(memoryview(shaped).cast("h", (128, 2)))
+		self.assertEqual(shaped, interleaved.tobytes())
+
+		# Strided view, writing every second sample of a larger buffer
+		sparse = array.array("h", bytes(256 * 2 * 2))
+		synths[3].getSamples(memoryview(sparse)[::2])
+		self.assertEqual(sparse[0::4], interleaved[0::2])
+		self.assertFalse(any(sparse[1::2]))
+
+		self.assertRaises(ValueError, synths[0].getSamples, left, bytearray(64 * 2))
+
+		# Unsigned samples are the same bits, and other contiguous buffers
+		# are still taken as raw bytes
+		for typecode in ("H", "i"):
+			synth = pyopl.opl(49716, sampleSize=2, channels=2)
+			synth.writeReg(0x105, 0x01)
+			synth.writeReg(0xC0, 0x10)
+			play_note(synth)
+			raw = array.array(typecode, bytes(128 * 2 * 2))
+			synth.getSamples(raw)
+			self.assertEqual(raw.tobytes(), interleaved.tobytes())
+
+	def test_stems(self) -> None:
+		for opl3 in (False, True):
+			mixed = pyopl.opl(49716, sampleSize=2, channels=2)
+			split = pyopl.opl(49716, sampleSize=2, channels=2)
+			for synth in (mixed, split):
+				if opl3:
+					synth.writeReg(0x105, 0x01)
+					synth.writeReg(0xC0, 0x30)
+				play_note(synth)
+				# Rhythm mode with a bass drum and snare
+				for op in (0x13, 0x14):
+					synth.writeReg(0x20 + op, 0x01)
+					synth.writeReg(0x40 + op, 0x08)
+					synth.writeReg(0x60 + op, 0xF0)
+				synth.writeReg(0xA6, 0x50)
+				synth.writeReg(0xB6, 0x09)
+				synth.writeReg(0xA7, 0x50)
+				synth.writeReg(0xB7, 0x0A)
+				synth.writeReg(0xBD, 0x38)
+
+			expected = array.array("h", bytes(256 * 2 * 2))
+			mixed.getSamples(expected)
+			stems = array.array("h", bytes(pyopl.STEM_LANES * 256 * 2 * 2))
+			split.getStems(stems)
+
+			lanes = [stems[lane * 512:(lane + 1) * 512] for lane in range(pyopl.STEM_LANES)]
+			active = [lane for lane in range(pyopl.STEM_LANES) if any(lanes[lane])]
+			self.assertEqual(active, [0, pyopl.STEM_LANES - 5, pyopl.STEM_LANES - 3])
+			self.assertEqual(array.array("h", map(sum, zip(*lanes))), expected)
+
+	def test_channel_mask(self) -> None:
+		reference = pyopl.opl(49716, sampleSize=2, channels=2)
+		masked = pyopl.opl(49716, sampleSize=2, channels=2)
+		for synth in (reference, masked):
+			play_note(synth)
+			synth.writeReg(0xC0, 0x0E)  # Maximum feedback
+
+		expected = bytearray(256 * 2 * 2)
+		buffer = bytearray(256 * 2 * 2)
+		for mask in (0x7FFFFE, 0x7FFFFF, 0x000001):
+			masked.set_channel_mask(mask)
+			for _ in range(3):
+				reference.getSamples(expected)
+				masked.getSamples(buffer)
+				if mask & 1:
+					# Unmuting carries on as though the channel was never muted
+					self.assertEqual(buffer, expected)
+				else:
+					self.assertEqual(buffer, bytes(len(buffer)))
+
+	def test_feedback_after_percussion(self) -> None:
+		# Feedback set on channel 7 in rhythm mode must apply once it's a
+		# normal channel again, as if it had been set afterwards
+		early = pyopl.opl(49716, sampleSize=2, channels=2)
+		late = pyopl.opl(49716, sampleSize=2, channels=2)
+		for synth in (early, late):
+			synth.writeReg(0xBD, 0x20)
+			if synth is early:
+				synth.writeReg(0xC7, 0x0E)
+			synth.writeReg(0xBD, 0x00)
+			if synth is late:
+				synth.writeReg(0xC7, 0x0E)
+			# A sine tone on channel 7, whose operators are 0x11 and 0x14
+			for reg, val in ((0x31, 0x01), (0x34, 0x01), (0x71, 0xF0), (0x74, 0xF0), (0xA7, 0x98), (0xB7, 0x31)):
+				synth.writeReg(reg, val)
+
+		expected = bytearray(512 * 2 * 2)
+		buffer = bytearray(len(expected))
+		late.getSamples(expected)
+		early.getSamples(buffer)
+		self.assertEqual(buffer, expected)
+
+	def test_frequency_bursts(self) -> None:
+		# A0 and B0 writes only take effect when the next block starts, or
+		# when another register is written first.  Bursts of them, with the
+		# 4-op, OPL3 and rhythm registers written between A0 and B0, must
+		# sound the same as when every write is followed by a block.  The
+		# keys are off until the end, so the blocks in between are silent.
+		setup = [(0x105, 0x01)]
+		for op in (0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x08, 0x0B):
+			setup += [(0x20 + op, 0x01), (0x40 + op, 0x10), (0x60 + op, 0xF4), (0x80 + op, 0x77)]
+		setup += [(0xC0, 0x31), (0xC1, 0x31), (0xC2, 0x31), (0xC3, 0x31)]
+		bursts = [
+			(0xA0, 0x98), (0x104, 0x01), (0xB0, 0x11),
+			(0xA3, 0x50), (0xB3, 0x0D),
+			(0xA1, 0x40), (0xBD, 0xC0), (0xB1, 0x12),
+			(0xA2, 0x80), (0x105, 0x00), (0xB2, 0x0E), (0x105, 0x01),
+			(0xA1, 0x60), (0x104, 0x00), (0xB1, 0x16), (0xA3, 0x70), (0xB3, 0x0D),
+			(0xA0, 0xC8), (0x104, 0x01), (0xB0, 0x11),
+		]
+		keys = [(0xB0, 0x31), (0xB1, 0x36), (0xB2, 0x2E), (0xB3, 0x2D)]
+
+		burst = pyopl.opl(49716, sampleSize=2, channels=2)
+		stepped = pyopl.opl(49716, sampleSize=2, channels=2)
+		block = bytearray(512 * 2 * 2)
+		for reg, val in setup:
+			burst.writeReg(reg, val)
+			stepped.writeReg(reg, val)
+		for reg, val in bursts:
+			burst.writeReg(reg, val)
+			stepped.writeReg(reg, val)
+			stepped.getSamples(block)
+			self.assertEqual(block, bytes(len(block)))
+		for reg, val in keys:
+			burst.writeReg(reg, val)
+			stepped.writeReg(reg, val)
+
+		expected = bytearray(len(block))
+		for _ in range(20):
+			burst.getSamples(block)
+			stepped.getSamples(expected)
+			self.assertEqual(block, expected)
+		self.assertTrue(any(block))
+
+	def test_silent_carrier_in_long_requests(self) -> None:
+		# The carrier decays below hearing, where a channel stops running,
+		# and is brought back by a 0x40 write without a new key-on.  Where
+		# it stops is checked at each LFO step, 256 samples apart at
+		# 49716Hz, so whole steps at a time must match longer requests.
+		# Shorter requests check more often, and already moved it.
+		outputs = []
+		for size in (512, 256):
+			synth = pyopl.opl(49716, sampleSize=2, channels=2)
+			for reg, val in ((0x20, 0x01), (0x23, 0x21), (0x40, 0x10), (0x43, 0x3F), (0x60, 0xF0), (0x63, 0xF9),
+					(0x80, 0x77), (0x83, 0x9F), (0xA0, 0x98), (0xB0, 0x31)):
+				synth.writeReg(reg, val)
+			output = bytearray()
+			buffer = bytearray(size * 2 * 2)
+			for i in range(200 * 512 // size):
+				if i * size == 100 * 512:
+					synth.writeReg(0x43, 0x00)
+				synth.getSamples(buffer)
+				output += buffer
+			outputs.append(output)
+		self.assertTrue(any(outputs[0][-1024:]))
+		self.assertEqual(outputs[0], outputs[1])
+
+	def test_four_op_lfo_after_disable(self) -> None:
+		# Clearing 0x104 leaves the pair on its 4-op handler until the next
+		# C0 write, so vibrato and tremolo on the second channel must still
+		# be followed at every LFO step.  At 49716Hz the steps are 256
+		# samples apart, so two samples at a time never span one.
+		synths = [pyopl.opl(49716, sampleSize=2, channels=2) for _ in range(2)]
+		for synth in synths:
+			synth.writeReg(0x105, 0x01)
+			synth.writeReg(0x104, 0x01)
+			synth.writeReg(0xBD, 0xC0)
+			for reg, val in ((0x20, 0x01), (0x23, 0x01), (0x28, 0xC1), (0x2B, 0xC1)):
+				synth.writeReg(reg, val)
+			for op in (0x00, 0x03, 0x08, 0x0B):
+				synth.writeReg(0x40 + op, 0x00)
+				synth.writeReg(0x60 + op, 0xF0)
+				synth.writeReg(0x80 + op, 0x77)
+			for ch in (0, 3):
+				synth.writeReg(0xC0 + ch, 0x31)
+				synth.writeReg(0xA0 + ch, 0x98)
+				synth.writeReg(0xB0 + ch, 0x31)
+			synth.writeReg(0x104, 0x00)
+
+		expected = bytearray()
+		pair = bytearray(2 * 2 * 2)
+		for i in range(200 * 256):
+			synths[0].getSamples(pair)
+			expected += pair
+			if i + 1 == 101 * 256:
+				synths[0].writeReg(0x104, 0x01)
+		buffer = bytearray(512 * 2 * 2)
+		for i in range(200):
+			synths[1].getSamples(buffer)
+			self.assertEqual(buffer, expected[i * len(buffer):(i + 1) * len(buffer)])
+			if i == 100:
+				synths[1].writeReg(0x104, 0x01)
+
+	def test_multiple_chips(self) -> None:
+		first = pyopl.opl(49716, sampleSize=2, channels=2)
+		second = pyopl.opl(49716, sampleSize=2, channels=2)
+		dual = pyopl.opl(49716, sampleSize=2, channels=2, chips=2)
+		play_note(first)
+		play_note(second, fnum=0x50)
+		play_note(dual)
+		play_note(dual, bank=0x200, fnum=0x50)
+		dual.set_chip_pan(0, 1.0, 0.0)
+		dual.set_chip_pan(1, 0.0, 1.0)
+
+		left = array.array("h", bytes(256 * 2 * 2))
+		right = array.array("h", bytes(256 * 2 * 2))
+		mixed = array.array("h", bytes(256 * 2 * 2))
+		for _ in range(3):
+			first.getSamples(left)
+			second.getSamples(right)
+			dual.getSamples(mixed)
+			self.assertEqual(mixed[0::2], left[0::2])
+			self.assertEqual(mixed[1::2], right[1::2])
+
+		self.assertRaises(ValueError, dual.writeReg, 0x400, 0)
+		self.assertRaises(ValueError, dual.set_chip_pan, 2, 1.0, 1.0)
+
+		# Every chip at full volume, doubled, clips instead of wrapping
+		single = pyopl.opl(49716, sampleSize=2, channels=2)
+		many = pyopl.opl(49716, sampleSize=2, channels=2, chips=64)
+		def play_loud(opl: pyopl.opl, chip: int) -> None:
+			"""Every channel of an OPL3 playing both operators at full volume."""
+			opl.writeReg(chip << 9 | 0x105, 0x01)
+			for bank in (chip << 9, chip << 9 | 0x100):
+				for ch in range(9):
+					for op in (ch % 3 + ch // 3 * 8, ch % 3 + ch // 3 * 8 + 3):
+						opl.writeReg(bank | 0x20 | op, 0x01)
+						opl.writeReg(bank | 0x60 | op, 0xF0)
+					opl.writeReg(bank | 0xC0 | ch, 0x31)
+					opl.writeReg(bank | 0xA0 | ch, 0x98)
+					opl.writeReg(bank | 0xB0 | ch, 0x31)
+
+		for chip in range(64):
+			play_loud(many, chip)
+			many.set_chip_pan(chip, 2.0, 2.0)
+		play_loud(single, 0)
+		quiet = array.array("h", bytes(512 * 2 * 2))
+		loud = array.array("h", bytes(512 * 2 * 2))
+		single.getSamples(quiet)
+		many.getSamples(loud)
+		self.assertEqual([(v > 0) - (v < 0) for v in loud], [(v > 0) - (v < 0) for v in quiet])
+		self.assertEqual(max(loud), 32767)
+
+	def test_chip_samples(self) -> None:
+		# Enough chips for them to be generated in lanes together
+		count = 12
+		separate = [pyopl.opl(49716, sampleSize=2, channels=2) for _ in range(count)]
+		together = pyopl.opl(49716, sampleSize=2, channels=2, chips=count)
+		for chip in range(count):
+			fnum = 0x60 + chip * 8
+			if chip % 3 == 0:
+				separate[chip].writeReg(0x105, 0x01)
+				together.writeReg(chip * 0x200 + 0x105, 0x01)
+			for synth, bank in ((separate[chip], 0), (together, chip * 0x200)):
+				play_note(synth, bank=bank, fnum=fnum)
+				# Feedback on a second channel
+				for reg in (0x21, 0x24, 0x41, 0x44, 0x61, 0x64, 0xA1, 0xB1, 0xC1):
+					synth.writeReg(bank | reg, {0xA1: fnum, 0xB1: 0x32, 0xC1: 0x3E}.get(reg, 0x22))
+
+		expected = array.array("h", bytes(count * 256 * 2 * 2))
+		chips = array.array("h", bytes(len(expected) * 2))
+		for _ in range(3):
+			for chip in range(count):
+				block = array.array("h", bytes(256 * 2 * 2))
+				separate[chip].getSamples(block)
+				expected[chip * 512:(chip + 1) * 512] = block
+			together.getChipSamples(chips)
+			self.assertEqual(chips, expected)
+
+		self.assertRaises(ValueError, together.getChipSamples, bytearray(2))
+
+	def test_generated_tables(self) -> None:
+		# dbopl_tables.h must match what the generator currently produces
+		root = Path(__file__).parent.parent
+		generate = runpy.run_path(str(root / "gen_dbopl_tables.py"))["generate"]
+		self.assertEqual((root / "dbopl_tables.h").read_text(), generate())
+
+	def test_new_instances(self) -> None:
+		# Later objects start from a clean chip, whatever earlier ones did
+		first = pyopl.opl(44100, sampleSize=2, channels=2)
+		play_note(first)
+		expected = bytearray(512 * 2 * 2)
+		first.getSamples(expected)
+		second = pyopl.opl(44100, sampleSize=2, channels=2)
+		buffer = bytearray(512 * 2 * 2)
+		second.getSamples(buffer)
+		self.assertEqual(buffer, bytes(len(buffer)))
+		third = pyopl.opl(44100, sampleSize=2, channels=2)
+		play_note(third)
+		third.getSamples(buffer)
+		self.assertEqual(buffer, expected)
+
+		self.assertGreater(sys.getsizeof(pyopl.opl(44100, 2, 2, chips=2)), sys.getsizeof(first))
+
+	def test_reset(self) -> None:
+		opl = pyopl.opl(44100, sampleSize=2, channels=2, chips=2)
+		play_note(opl, bank=0x200)
+		opl.set_chip_pan(1, 0.0, 1.0)
+		opl.set_channel_mask(0)
+		buffer = bytearray(512 * 2 * 2)
+		opl.getSamples(buffer)
+		opl.reset()
+		self.assertEqual(opl.readReg(0x2B0), 0)
+		opl.getSamples(buffer)
+		self.assertEqual(buffer, bytes(len(buffer)))
+
+		fresh = pyopl.opl(44100, sampleSize=2, channels=2, chips=2)
+		expected = bytearray(len(buffer))
+		for obj, out in ((opl, buffer), (fresh, expected)):
+			play_note(obj, bank=0x200)
+			obj.getSamples(out)
+		self.assertEqual(buffer, expected)
+
+	def test_pool(self) -> None:
+		pool = pyopl.pool(2, 44100, sampleSize=2, channels=2)
+		self.assertEqual(len(pool), 2)
+		first = pool.acquire()
+		second = pool.acquire()
+		self.assertIsInstance(first, pyopl.opl)
+		self.assertIsNot(first, second)
+		self.assertRaises(IndexError, pool.acquire)
+
+		fresh = pyopl.opl(44100, sampleSize=2, channels=2)
+		expected = bytearray(512 * 2 * 2)
+		buffer = bytearray(len(expected))
+		play_note(fresh)
+		fresh.getSamples(expected)
+		play_note(first, fnum=0x50)
+		first.getSamples(buffer)
+		pool.release(first)
+		self.assertRaises(ValueError, pool.release, first)
+		self.assertRaises(ValueError, pool.release, fresh)
+		self.assertEqual(len(pool), 1)
+
+		# Released objects come back as new
+		again = pool.acquire()
+		play_note(again)
+		again.getSamples(buffer)
+		self.assertEqual(buffer, expected)
+
+		# Objects outlive the pool they came from
+		del pool
+		play_note(second)
+		second.getSamples(buffer)
+		self.assertEqual(buffer, expected)
+
+	def test_threads(self) -> None:
+		# Separate objects in separate threads give the same output as in one
+		def render(fnum: int, blocks: int) -> bytes:
+			opl = pyopl.opl(44100, sampleSize=2, channels=2)
+			play_note(opl, fnum=fnum)
+			buffer = bytearray(256 * 2 * 2)
+			output = bytearray()
+			for _ in range(blocks):
+				opl.getSamples(buffer)
+				output += buffer
+			return bytes(output)
+
+		fnums = [0x40 + i * 0x10 for i in range(8)]
+		expected = [render(fnum, 20) for fnum in fnums]
+		results = [b""] * len(fnums)
+		errors = []
+
+		def separate(index: int) -> None:
+			try:
+				results[index] = render(fnums[index], 20)
+			except Exception as e:
+				errors.append(e)
+
+		# One object and one pool hammered from every thread at once, with
+		# enough objects in the pool for every thread
+		shared = pyopl.opl(44100, sampleSize=2, channels=2, chips=2)
+		pool = pyopl.pool(8, 44100, sampleSize=2, channels=2)
+
+		def call_shared(method, *args) -> None:
+			try:
+				method(*args)
+			except RuntimeError as e:
+				# Only allowed to fail while another thread is rendering
+				if "busy" not in str(e):
+					raise
+
+		def hammer(index: int) -> None:
+			try:
+				buffer = array.array("h", bytes(128 * 2 * 2))
+				long_buffer = bytearray(4096 * 2 * 2)
+				for i in range(50):
+					reg = 0x200 * (index & 1) + 0xA0 + (index % 9)
+					call_shared(shared.writeReg, reg, i)
+					call_shared(shared.readReg, reg)
+					call_shared(shared.getSamples, buffer)
+					call_shared(shared.stream, 64)
+					call_shared(shared.render, [(0, reg, i), (100, reg, i + 1)], long_buffer)
+					opl = pool.acquire()
+					opl.writeReg(0xB0, 0x31)
+					opl.getSamples(buffer)
+					pool.release(opl)
+			except Exception as e:
+				errors.append(e)
+
+		threads = [threading.Thread(target=separate, args=(i,)) for i in range(len(fnums))]
+		threads += [threading.Thread(target=hammer, args=(i,)) for i in range(8)]
+		for thread in threads:
+			thread.start()
+		for thread in threads:
+			thread.join()
+
+		self.assertEqual(errors, [])
+		self.assertEqual(results, expected)
+		self.assertEqual(len(pool), 8)
+
+	@unittest.skipUnless(_interpreters, "needs the Python 3.13 _interpreters module")
+	def test_subinterpreter(self) -> None:
+		# Isolated interpreters have their own GIL and their own copy of the module
+		interp = _interpreters.create(_interpreters.new_config("isolated"))
+		try:
+			error = _interpreters.exec(interp, (
+				"import pyopl\n"
+				"opl = pyopl.opl(44100, 2, 2)\n"
+				"opl.writeReg(0xA0, 0x98)\n"
+				"buffer = bytearray(512 * 2 * 2)\n"
+				"opl.getSamples(buffer)\n"
+				"pool = pyopl.pool(2, 44100, 2, 2)\n"
+				"pool.release(pool.acquire())\n"
+				"assert opl.readReg(0xA0) == 0x98\n"
+				# Left rendering as the interpreter is destroyed
+				"import asyncio\n"
+				"async def main():\n"
+				"	pyopl.opl(49716, 2, 2).render_async([], bytearray(49716 * 600 * 4))\n"
+				"asyncio.run(main())\n"
+			))
+		finally:
+			_interpreters.destroy(interp)
+		self.assertIsNone(error)
+
+	def test_read_reg(self) -> None:
+		opl = pyopl.opl(49716, sampleSize=2, channels=2, chips=2)
+		play_note(opl, bank=0x200)
+		self.assertEqual(opl.readReg(0x2A0), 0x98)
+		self.assertEqual(opl.readReg(0x2B0), 0x31)
+		self.assertEqual(opl.readReg(0xA0), 0)
+		self.assertRaises(ValueError, opl.readReg, 0x400)
+
+		# Channel 3 is the 2nd half of a 4-op pair, so the chip ignores its
+		# frequency until 4-op mode is switched off again
+		paired = pyopl.opl(49716, sampleSize=2, channels=2)
+		plain = pyopl.opl(49716, sampleSize=2, channels=2)
+		paired.writeReg(0x105, 0x01)
+		paired.writeReg(0x104, 0x01)
+		paired.writeReg(0xA3, 0x98)
+		paired.writeReg(0x104, 0x00)
+		plain.writeReg(0x105, 0x01)
+		for opl in (paired, plain):
+			for reg, val in ((0x28, 0x01), (0x2B, 0x01), (0x48, 0x10), (0x68, 0xF0),
+					(0x6B, 0xF0), (0x88, 0x77), (0x8B, 0x77), (0xC3, 0x30),
+					(0xA3, 0x98), (0xB3, 0x31)):
+				opl.writeReg(reg, val)
+				# Rewriting a register makes no difference
+				opl.writeReg(reg, val)
+		first = bytearray(512 * 2 * 2)
+		second = bytearray(512 * 2 * 2)
+		paired.getSamples(first)
+		plain.getSamples(second)
+		self.assertEqual(first, second)
+		self.assertNotEqual(first, bytes(len(first)))
+
+	def test_call_arguments(self) -> None:
+		opl = pyopl.opl(49716, sampleSize=2, channels=2)
+		opl.writeReg(0x20, 0x01)
+		opl.writeReg(0x21, val=0x02)
+		opl.writeReg(val=0x03, reg=0x22)
+		self.assertEqual([opl.readReg(r) for r in (0x20, 0x21, 0x22)], [1, 2, 3])
+		self.assertRaises(TypeError, opl.writeReg, 0x20)
+		self.assertRaises(TypeError, opl.writeReg, 0x20, 1, 2)
+		self.assertRaises(TypeError, opl.writeReg, 0x20, reg=0x20)
+		self.assertRaises(TypeError, opl.writeReg, 0x20, value=1)
+		self.assertRaises(TypeError, opl.writeReg, 0x20, "1")
+		self.assertRaises(OverflowError, opl.writeReg, 0x20, 1 << 40)
+		self.assertRaises(TypeError, opl.readReg)
+		self.assertRaises(TypeError, opl.getSamples)
+		self.assertRaises(TypeError, opl.getSamples, bytearray(8), bytearray(8), bytearray(8))
+		self.assertRaises(TypeError, opl.stream, 2.0)
+
+	def test_preview(self) -> None:
+		for preview in (0, 3, 32):
+			self.assertRaises(ValueError, pyopl.opl, 49716, 2, 2, preview=preview)
+		self.assertRaises(ValueError, pyopl.opl, 8, 2, 2, preview=16)
+
+		test_dir = Path(__file__).parent
+		exact = array.array("h", DROPlayer(str(test_dir / "correct_answer.dro")).render_dro())
+		for preview in (1, 4, 16):
+			rendered = array.array("h", DROPlayer(str(test_dir / "correct_answer.dro"), preview).render_dro())
+			self.assertEqual(len(rendered), len(exact))
+			if preview == 1:
+				self.assertEqual(rendered, exact)
+				continue
+			# Loud stretches stay within a few dB of the exact output
+			for start in range(0, len(exact), 2048):
+				expected = sum(x * x for x in exact[start:start + 2048])
+				actual = sum(x * x for x in rendered[start:start + 2048])
+				if expected > 2048 * 327 ** 2:
+					self.assertLess(abs(math.log10(actual / expected)) * 10, 4)
+
+	def test_render(self) -> None:
+		# A few notes with feedback, vibrato and tremolo over one second
+		events = [
+			(0, 0x01, 0x20),
+			(0, 0xBD, 0xC0),
+			(0, 0x20, 0xE1),
+			(0, 0x23, 0xC2),
+			(0, 0xE0, 0x01),
+			(0, 0x63, 0xF4),
+			(0, 0x83, 0x26),
+			(0, 0xC0, 0x0E),
+		]
+		for frame, note in zip(range(0, 48000, 6000), (0x98, 0x50, 0x20, 0x90)):
+			events += [(frame, 0xA0, note), (frame, 0xB0, 0x31), (frame + 4000, 0xB0, 0x11)]
+		events.sort(key=lambda event: event[0])
+
+		reference = pyopl.opl(49716, sampleSize=2, channels=2)
+		expected = bytearray()
+		buffer = bytearray(100 * 2 * 2)
+		position = 0
+		for frame, reg, val in events + [(49716, 0, 0)]:
+			while position < frame:
+				samples = min(100, frame - position)
+				reference.getSamples(memoryview(buffer)[:samples * 4])
+				expected += buffer[:samples * 4]
+				position += samples
+			reference.writeReg(reg, val)
+		expected_after = bytearray(512 * 2 * 2)
+		reference.getSamples(expected_after)
+
+		for threads in (1, 4):
+			rendered = bytearray(49716 * 2 * 2)
+			synth = pyopl.opl(49716, sampleSize=2, channels=2)
+			synth.render(events, rendered, threads=threads)
+			self.assertEqual(rendered, expected)
+
+			# Carries on from the end of the song as though it was played normally
+			after = bytearray(512 * 2 * 2)
+			synth.getSamples(after)
+			self.assertEqual(after, expected_after)
+
+		self.assertRaises(ValueError, synth.render, [(10, 0x20, 1), (5, 0x20, 2)], bytearray(100))
+
+	def test_render_split_mid_block(self) -> None:
+		# The carrier fades below hearing just before the block ending at
+		# 22528, and is brought back later.  A channel whose carrier is
+		# silent skips the whole block, so a segment starting at 22520 has
+		# to begin where a single-threaded render would start a block.
+		events = [
+			(0, 0x20, 0x21),
+			(0, 0x23, 0x21),
+			(0, 0x40, 0x10),
+			(0, 0x43, 0x3F),
+			(0, 0x60, 0xF0),
+			(0, 0x63, 0xF5),
+			(0, 0x83, 0xAF),
+			(0, 0xA0, 0x98),
+			(0, 0xB0, 0x31),
+			(30000, 0x43, 0x00),
+		]
+		expected = bytearray(22520 * 2 * 2 * 2)
+		pyopl.opl(49716, sampleSize=2, channels=2).render(events, expected)
+		for kwargs in ({"threads": 2}, {"groups": 2}):
+			rendered = bytearray(len(expected))
+			pyopl.opl(49716, sampleSize=2, channels=2).render(events, rendered, **kwargs)
+			self.assertEqual(rendered, expected)
+
+	def test_render_groups(self) -> None:
+		# Two OPL3 chips with a 4-op pair, percussion and vibrato, changing
+		# modes part way through so the groups have to follow along
+		events = [(0, 0x01, 0x20), (0, 0x105, 0x01), (0, 0x305, 0x01), (0, 0x104, 0x01)]
+		for bank in (0, 0x200):
+			for op in (0x00, 0x03, 0x08, 0x0B, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15):
+				events += [(0, bank | 0x20 | op, 0x61), (0, bank | 0x40 | op, 0x10), (0, bank | 0x60 | op, 0xF4), (0, bank | 0xE0 | op, 0x02)]
+			for ch in range(9):
+				events += [(0, bank | 0xC0 | ch, 0x3E), (0, bank | 0xA0 | ch, 0x40 + ch * 16), (0, bank | 0xB0 | ch, 0x31)]
+			events += [(0, bank | 0xBD, 0xFF), (25000, bank | 0xBD, 0xC0), (25000, bank | 0x105, 0x00)]
+		events += [(30000, 0xB3, 0x11), (40000, 0x104, 0x00), (40000, 0x304, 0x02)]
+		events.sort(key=lambda event: event[0])
+
+		expected = bytearray(49716 * 2 * 2)
+		expected_after = bytearray(512 * 2 * 2)
+		reference = pyopl.opl(49716, sampleSize=2, channels=2, chips=2)
+		reference.render(events, expected)
+		reference.getSamples(expected_after)
+		for groups in (2, 3, 16):
+			rendered = bytearray(len(expected))
+			synth = pyopl.opl(49716, sampleSize=2, channels=2, chips=2)
+			synth.render(events, rendered, groups=groups)
+			self.assertEqual(rendered, expected)
+
+			after = bytearray(512 * 2 * 2)
+			synth.getSamples(after)
+			self.assertEqual(after, expected_after)
+
+		self.assertRaises(ValueError, synth.render, events, rendered, threads=2, groups=2)
+		self.assertRaises(ValueError, synth.render, events, rendered, groups=0)
+
+	def test_render_offset(self) -> None:
+		from multiprocessing import shared_memory
+
+		events = [(0, 0x20, 0x01), (0, 0x23, 0x01), (0, 0x63, 0xF4), (0, 0xA0, 0x98), (0, 0xB0, 0x31), (300, 0xB0, 0x11)]
+		expected = bytearray(1000 * 2 * 2)
+		pyopl.opl(49716, sampleSize=2, channels=2).render(events, expected)
+
+		# Two renders side by side in one segment, passed without slicing
+		shm = shared_memory.SharedMemory(create=True, size=2500 * 2 * 2)
+		try:
+			pyopl.opl(49716, sampleSize=2, channels=2).render(events, shm, offset=100, frames=1000)
+			pyopl.opl(49716, sampleSize=2, channels=2).render(events, shm.buf, offset=1500)
+			self.assertEqual(shm.buf[:100 * 4], bytes(100 * 4))
+			self.assertEqual(shm.buf[100 * 4:1100 * 4], expected)
+			self.assertEqual(shm.buf[1500 * 4:], expected)
+			self.assertRaises(ValueError, pyopl.opl(49716, sampleSize=2, channels=2).render, [], shm, offset=2000, frames=1000)
+		finally:
+			shm.close()
+			shm.unlink()
+
+	def test_render_async(self) -> None:
+		events = [(0, 0x20, 0x01), (0, 0x23, 0x01), (0, 0x63, 0xF4), (0, 0xA0, 0x98), (0, 0xB0, 0x31), (30000, 0xB0, 0x11)]
+		expected = bytearray(50000 * 2 * 2)
+		pyopl.opl(49716, sampleSize=2, channels=2).render(events, expected)
+
+		async def main() -> None:
+			synths = [pyopl.opl(49716, sampleSize=2, channels=2) for _ in range(4)]
+			buffers = [bytearray(len(expected)) for _ in synths]
+			await asyncio.gather(*[synth.render_async(events, buf) for synth, buf in zip(synths, buffers)])
+			for buf in buffers:
+				self.assertEqual(buf, expected)
+
+			# A cancelled render stops at the end of a chunk, and the object
+			# can be used again once its worker has let go of it
+			synth = synths[0]
+			long_buffer = bytearray(49716 * 60 * 2 * 2)
+			task = asyncio.ensure_future(synth.render_async(events, long_buffer))
+			await asyncio.sleep(0)
+			self.assertRaises(RuntimeError, synth.writeReg, 0xB0, 0x00)
+			task.cancel()
+			with self.assertRaises(asyncio.CancelledError):
+				await task
+			for _ in range(1000):
+				try:
+					synth.writeReg(0xB0, 0x00)
+					break
+				except RuntimeError:
+					await asyncio.sleep(0.001)
+			self.assertEqual(long_buffer[-1024:], bytes(1024))
+
+			# A capture only records the writes and time actually rendered
+			# before the cancel.  At 1kHz a frame is a millisecond.
+			synth = pyopl.opl(1000, sampleSize=2, channels=2)
+			synth.start_capture()
+			task = asyncio.ensure_future(synth.render_async([(k * 50000, 0x20, k) for k in range(1, 60)], long_buffer))
+			await asyncio.sleep(0)
+			task.cancel()
+			with self.assertRaises(asyncio.CancelledError):
+				await task
+			for _ in range(1000):
+				try:
+					synth.stop_capture()
+					break
+				except RuntimeError:
+					await asyncio.sleep(0.001)
+			last = synth.readReg(0x20)
+			captured = synth.export_dro()
+			with tempfile.TemporaryDirectory() as tmp:
+				path = Path(tmp) / "capture.dro"
+				path.write_bytes(captured)
+				writes = [entry[3] for entry in read_dro(str(path)) if entry[0] == DROInstructionType.REGISTER]
+			self.assertEqual(writes, list(range(1, last + 1)))
+			length_ms = int.from_bytes(captured[16:20], "little")
+			self.assertGreaterEqual(length_ms, last * 50000)
+			self.assertLessEqual(length_ms, (last + 1) * 50000)
+
+		asyncio.run(main())
+		# There has to be a loop to finish the future on
+		self.assertRaises(RuntimeError, pyopl.opl(49716, sampleSize=2, channels=2).render_async, events, expected)
+
+	def test_render_async_at_exit(self) -> None:
+		# A render still going when the interpreter exits is stopped
+		# without its worker needing the interpreter again
+		code = (
+			"import asyncio, pyopl\n"
+			"async def main():\n"
+			"	pyopl.opl(49716, 2, 2).render_async([], bytearray(49716 * 600 * 4))\n"
+			"	await asyncio.sleep(0)\n"
+			"asyncio.run(main())\n"
+		)
+		result = subprocess.run([sys.executable, "-c", code], cwd=str(Path(pyopl.__file__).parent),
+			capture_output=True, timeout=60)
+		self.assertEqual(result.returncode, 0, result.stderr)
+		self.assertEqual(result.stderr, b"")
+
+	def test_capture_dro(self) -> None:
+		def parse(data: bytes) -> list:
+			"""Read a DRO file's contents, merging delays however they're coded."""
+			with tempfile.TemporaryDirectory() as tmp:
+				path = Path(tmp) / "capture.dro"
+				path.write_bytes(data)
+				dro = read_dro(str(path))
+			entries = []
+			for entry in dro:
+				if entry[0] != DROInstructionType.DELAY_MS:
+					entries.append(tuple(entry[1:]))
+				elif entries and entries[-1][0] == "delay":
+					entries[-1] = ("delay", entries[-1][1] + entry[1])
+				else:
+					entries.append(("delay", entry[1]))
+			return entries
+
+		# At 1kHz every frame is a millisecond, so a song played through
+		# render() comes back with exactly the same timing
+		original = (Path(__file__).parent / "correct_answer.dro").read_bytes()
+		events = []
+		now = 0
+		for entry in parse(original):
+			if entry[0] == "delay":
+				now += entry[1]
+			else:
+				bank, reg, val = entry
+				events.append((now, reg | (bank << 8), val))
+		synth = pyopl.opl(1000, sampleSize=2, channels=2)
+		synth.start_capture()
+		synth.render(events, bytearray(now * 2 * 2))
+		synth.stop_capture()
+		synth.writeReg(0xB0, 0x00)
+		captured = synth.export_dro()
+		self.assertEqual(parse(captured), parse(original))
+		self.assertEqual(captured[20], original[20])
+		self.assertLessEqual(len(captured), len(original))
+
+		# A capture started part way through starts with the registers
+		# already set, keying on last, and a second chip is a dual OPL2
+		dual = pyopl.opl(49716, sampleSize=2, channels=2, chips=2)
+		play_note(dual, 0x200)
+		dual.start_capture()
+		dual.getSamples(bytearray(497 * 2 * 2))
+		dual.writeReg(0x2B0, 0x11)
+		captured = dual.export_dro()
+		self.assertEqual(captured[20], 1)
+		self.assertEqual(parse(captured), [
+			(1, 0x20, 0x01), (1, 0x23, 0x01), (1, 0x40, 0x10), (1, 0x60, 0xF0), (1, 0x63, 0xF0),
+			(1, 0x80, 0x77), (1, 0x83, 0x77), (1, 0xA0, 0x98), (1, 0xB0, 0x31),
+			("delay", 10), (1, 0xB0, 0x11),
+		])
+
+		dual.writeReg(0x105, 0x01)
+		self.assertRaises(ValueError, dual.export_dro)
+		dual.reset()
+		self.assertRaises(RuntimeError, dual.export_dro)
+
+	def test_sink(self) -> None:
+		events = [(0, 0x20 | op, 0x01) for op in (0x00, 0x03)]
+		events += [(0, 0x60 | op, 0xF4) for op in (0x00, 0x03)]
+		events += [(0, 0xA0, 0x98), (0, 0xB0, 0x31), (40000, 0xB0, 0x11), (70000, 0xA0, 0x40)]
+		expected = bytearray(80000 * 2 * 2)
+		pyopl.opl(49716, sampleSize=2, channels=2).render(events, expected)
+
+		with tempfile.TemporaryDirectory() as tmp:
+			path = Path(tmp) / "sink.wav"
+			for mmap_frames in (0, 100000):
+				# Rendered in two calls, the second carrying on from the first
+				synth = pyopl.opl(49716, sampleSize=2, channels=2)
+				with open(path, "w+b") as f:
+					with pyopl.sink(synth, f, mmap_frames=mmap_frames) as sink:
+						sink.render(events[:-2], 40000)
+						sink.render([(frame - 40000, reg, val) for frame, reg, val in events[-2:]], 40000)
+					self.assertRaises(ValueError, sink.render, [], 10)
+				with wave.open(str(path), "rb") as wav_file:
+					self.assertEqual(wav_file.getnchannels(), 2)
+					self.assertEqual(wav_file.getframerate(), 49716)
+					self.assertEqual(wav_file.getnframes(), 80000)
+					self.assertEqual(wav_file.readframes(80000), expected)
+
+			# Raw samples are written after whatever is already in the file
+			synth = pyopl.opl(49716, sampleSize=2, channels=2)
+			with open(path, "wb") as f:
+				f.write(b"head")
+				f.flush()
+				with pyopl.sink(synth, f, wav=False) as sink:
+					sink.render(events, 80000)
+			self.assertEqual(path.read_bytes(), b"head" + expected)
+
+			# Closing the file first must not send the header and the last
+			# writes into another file that reuses its descriptor
+			synth = pyopl.opl(49716, sampleSize=2, channels=2)
+			with open(path, "wb") as f:
+				sink = pyopl.sink(synth, f)
+				sink.render(events, 80000)
+			other = Path(tmp) / "other.bin"
+			with open(other, "wb") as f:
+				f.write(b"other")
+				f.flush()
+				del sink
+			self.assertEqual(other.read_bytes(), b"other")
+			with wave.open(str(path), "rb") as wav_file:
+				self.assertEqual(wav_file.getnframes(), 80000)
+				self.assertEqual(wav_file.readframes(80000), expected)
+
+	@unittest.skipUnless(numpy, "numpy not installed")
+	def test_numpy_layouts(self) -> None:
+		reference = pyopl.opl(49716, sampleSize=2, channels=2)
+		reference.writeReg(0x105, 0x01)
+		reference.writeReg(0xC0, 0x10)
+		play_note(reference)
+		expected = numpy.zeros((256, 2), dtype=numpy.int16)
+		reference.getSamples(expected)
+
+		for order in "CF":
+			synth = pyopl.opl(49716, sampleSize=2, channels=2)
+			synth.writeReg(0x105, 0x01)
+			synth.writeReg(0xC0, 0x10)
+			play_note(synth)
+			out = numpy.zeros((256, 2), dtype=numpy.int16, order=order)
+			synth.getSamples(out)
+			numpy.testing.assert_array_equal(out, expected)
+
 
 if __name__ == "__main__":
 	unittest.main()